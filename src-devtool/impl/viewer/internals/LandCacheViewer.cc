@@ -1,16 +1,17 @@
 #include "LandCacheViewer.h"
 
 #include "pland/PLand.h"
+#include "pland/infra/PlayerNameCache.h"
 #include "pland/land/LandRegistry.h"
 
 #include "mc/platform/UUID.h"
 
-#include "ll/api/service/PlayerInfo.h"
-
 #include <filesystem>
 #include <imgui_internal.h>
+#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 
 namespace devtool::internals {
@@ -59,20 +60,40 @@ void LandCacheViewerWindow::handleExportLand(land::SharedLand land) {
 }
 
 void LandCacheViewerWindow::preBuildData() {
-    lands_ = land::PLand::getInstance().getLandRegistry().getLandsByOwner();
+    auto& registry = land::PLand::getInstance().getLandRegistry();
+    lands_         = registry.getLandsByOwner();
+
+    // 名称搜索走注册表的三元组索引，仅在关键字或名称变化时重新搜索
+    auto version = registry.getNameIndexVersion();
+    if (nameMatchedFilter_ != nameFilter_ || nameMatchedVersion_ != version) {
+        nameMatchedFilter_  = nameFilter_;
+        nameMatchedVersion_ = version;
+        nameMatched_.clear();
+        if (!nameMatchedFilter_.empty()) {
+            auto result = registry.fuzzySearchLands(nameMatchedFilter_, 0, std::numeric_limits<size_t>::max());
+            for (auto const& match : result.matches) {
+                nameMatched_.insert(match.id);
+            }
+        }
+    }
 
-    auto& playerInfo = ll::service::PlayerInfo::getInstance();
+    // 更新玩家名缓存，未缓存的玩家一次性批量解析
+    std::vector<mce::UUID> missing;
     for (const auto& owner : lands_ | std::views::keys) {
-        // 更新玩家名缓存
         if (!realNames_.contains(owner)) {
-            auto info         = playerInfo.fromUuid(owner);
-            realNames_[owner] = info.has_value() ? info->name : owner.asString();
+            missing.push_back(owner);
         }
         // 更新 CheckBox
         if (!isShow_.contains(owner)) {
             isShow_[owner] = false;
         }
     }
+    if (!missing.empty()) {
+        auto names = land::PLand::getInstance().getPlayerNameCache()->resolve(missing);
+        for (size_t i = 0; i < missing.size(); ++i) {
+            realNames_[missing[i]] = std::move(names[i]);
+        }
+    }
 
     // 移除不存在的玩家
     for (auto iter = realNames_.begin(); iter != realNames_.end();) {
@@ -107,6 +128,7 @@ void LandCacheViewerWindow::renderToolBar() {
         showSubLand_       = true;
         dimensionFilter_   = -1;
         idFilter_          = -1;
+        nameFilter_[0]     = '\0';
         isShow_.clear();
     }
     ImGui::SameLine();
@@ -134,6 +156,9 @@ void LandCacheViewerWindow::renderToolBar() {
     ImGui::SameLine(0, 20);
     ImGui::SetNextItemWidth(130);
     ImGui::InputInt("领地ID查询", &idFilter_);
+    ImGui::SameLine(0, 20);
+    ImGui::SetNextItemWidth(160);
+    ImGui::InputText("名称搜索", nameFilter_, sizeof(nameFilter_));
     ImGui::EndGroup();
 }
 
@@ -170,7 +195,8 @@ void LandCacheViewerWindow::renderCacheLand() {
                 continue;
             }
             if ((dimensionFilter_ != -1 && ld->getDimensionId() != dimensionFilter_)
-                || (idFilter_ != -1 && ld->getId() != idFilter_)) {
+                || (idFilter_ != -1 && ld->getId() != idFilter_)
+                || (nameFilter_[0] != '\0' && !nameMatched_.contains(ld->getId()))) {
                 continue;
             }
 
@@ -251,6 +277,7 @@ void LandEditor::renderMenuElement() {
                 auto json = nlohmann::json::parse(editor_.GetText());
                 land->load(json);
                 land->save(true); // 由于 load 方法不会标记数据已更改，主动强制保存
+                land::PLand::getInstance().getLandRegistry().refreshLandName(*land);
             } catch (...) {
                 land->load(backup);
                 land::PLand::getInstance().getSelf().getLogger().error("Failed to parse json");
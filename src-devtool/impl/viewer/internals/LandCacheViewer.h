@@ -18,10 +18,11 @@ class LandEditor : public CodeEditor {
 };
 
 class LandCacheViewerWindow : public IWindow {
-    std::unordered_map<mce::UUID, std::unordered_set<land::SharedLand>> lands_;     // 领地缓存
-    std::unordered_map<mce::UUID, std::string>                          realNames_; // 玩家名缓存
-    std::unordered_map<mce::UUID, bool>                                 isShow_;    // 是否显示该玩家的领地
-    std::unordered_map<land::LandID, std::unique_ptr<LandEditor>>       editors_;   // 领地数据编辑器
+    std::unordered_map<mce::UUID, std::unordered_set<land::SharedLand>> lands_;       // 领地缓存
+    std::unordered_map<mce::UUID, std::string>                          realNames_;   // 玩家名缓存
+    std::unordered_map<mce::UUID, bool>                                 isShow_;      // 是否显示该玩家的领地
+    std::unordered_map<land::LandID, std::unique_ptr<LandEditor>>       editors_;     // 领地数据编辑器
+    std::unordered_set<land::LandID>                                    nameMatched_; // 名称搜索命中的领地
 
     bool showAllPlayerLand_{true}; // 是否显示所有玩家的领地
     bool showOrdinaryLand_{true};  // 是否显示普通领地
@@ -30,6 +31,10 @@ class LandCacheViewerWindow : public IWindow {
     bool showSubLand_{true};       // 是否显示子领地
     int  dimensionFilter_{-1};     // 维度过滤
     int  idFilter_{-1};            // 领地ID过滤
+    char nameFilter_[64]{};        // 名称模糊搜索
+
+    std::string nameMatchedFilter_;     // nameMatched_ 对应的搜索关键字
+    uint64_t    nameMatchedVersion_{0}; // nameMatched_ 对应的名称索引版本
 
 public:
     explicit LandCacheViewerWindow();
@@ -1,7 +1,12 @@
 #include "pland/PLand.h"
 #include "BuildInfo.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <ranges>
+#include <thread>
+#include <vector>
 
 #include "ll/api/Versions.h"
 #include "ll/api/data/Version.h"
@@ -17,9 +22,14 @@
 #include "pland/adapter/telemetry/Telemetry.h"
 #include "pland/command/Command.h"
 #include "pland/economy/EconomySystem.h"
+#include "pland/economy/PriceCalculate.h"
 #include "pland/events/ConfigReloadEvent.h"
 #include "pland/hooks/EventListener.h"
+#include "pland/hooks/EventTrace.h"
+#include "pland/hooks/ListenerStats.h"
 #include "pland/infra/Config.h"
+#include "pland/infra/JobScheduler.h"
+#include "pland/infra/PlayerNameCache.h"
 #include "pland/infra/SafeTeleport.h"
 #include "pland/land/LandRegistry.h"
 #include "pland/land/LandScheduler.h"
@@ -36,6 +46,8 @@ namespace land {
 struct PLand::Impl {
     ll::mod::NativeMod&                             mSelf;
     std::unique_ptr<ll::thread::ThreadPoolExecutor> mThreadPoolExecutor{nullptr};
+    std::unique_ptr<JobScheduler>                   mJobScheduler{nullptr};
+    std::unique_ptr<PlayerNameCache>                mPlayerNameCache{nullptr};
     std::unique_ptr<LandRegistry>                   mLandRegistry{nullptr};
     std::unique_ptr<LandScheduler>                  mLandScheduler{nullptr};
     std::unique_ptr<EventListener>                  mEventListener{nullptr};
@@ -69,8 +81,12 @@ bool PLand::load() {
 
     Config::tryLoad();
     logger.setLevel(Config::cfg.logLevel);
+    PriceCalculate::reloadCache();
 
-    mImpl->mThreadPoolExecutor = std::make_unique<ll::thread::ThreadPoolExecutor>("PLand-ThreadPool", 2);
+    // 线程池按核心数取一半(至少 2 个线程)，后台任务最多占用其中 n-1 个，为异步查询等留出 1 个线程
+    auto const threads         = std::max(std::thread::hardware_concurrency(), 4u) / 2;
+    mImpl->mThreadPoolExecutor = std::make_unique<ll::thread::ThreadPoolExecutor>("PLand-ThreadPool", threads);
+    mImpl->mJobScheduler       = std::make_unique<JobScheduler>(*mImpl->mThreadPoolExecutor, threads - 1);
 
     mImpl->mLandRegistry = std::make_unique<land::LandRegistry>();
     EconomySystem::getInstance().initEconomySystem();
@@ -85,12 +101,23 @@ bool PLand::load() {
 
 bool PLand::enable() {
     LandCommand::setup();
+    mImpl->mPlayerNameCache   = std::make_unique<PlayerNameCache>();
     mImpl->mLandScheduler     = std::make_unique<LandScheduler>();
     mImpl->mEventListener     = std::make_unique<EventListener>();
     mImpl->mSafeTeleport      = std::make_unique<SafeTeleport>();
     mImpl->mSelectorManager   = std::make_unique<SelectorManager>();
     mImpl->mDrawHandleManager = std::make_unique<DrawHandleManager>();
     mImpl->mTelemetry         = std::make_unique<adapter::Telemetry>();
+    ListenerStats::setEnabled(Config::cfg.internal.listenerStats);
+    EventTrace::setSampleRate(Config::cfg.internal.eventTraceSampleRate);
+    {
+        // 预热玩家名缓存，领地提示与管理 GUI 首次显示时无需同步查询
+        auto                   lands = getLandRegistry().getLandsByOwner();
+        std::vector<mce::UUID> owners;
+        owners.reserve(lands.size());
+        std::ranges::copy(lands | std::views::keys, std::back_inserter(owners));
+        mImpl->mPlayerNameCache->prefetch(std::move(owners));
+    }
     if (Config::cfg.internal.telemetry) {
         mImpl->mTelemetry->launch(*getThreadPool());
     }
@@ -101,8 +128,11 @@ bool PLand::enable() {
         [this](events::ConfigReloadEvent& ev [[maybe_unused]]) {
             mImpl->mEventListener.reset();
             mImpl->mEventListener = std::make_unique<EventListener>();
+            ListenerStats::setEnabled(ev.getConfig().internal.listenerStats);
+            EventTrace::setSampleRate(ev.getConfig().internal.eventTraceSampleRate);
 
             EconomySystem::getInstance().reloadEconomySystem();
+            PriceCalculate::reloadCache();
 
             if (ev.getConfig().internal.telemetry) {
                 mImpl->mTelemetry->launch(*getThreadPool());
@@ -149,8 +179,10 @@ bool PLand::disable() {
     mImpl->mLandRegistry.reset();
 
     logger.debug("Destroying thread pool...");
+    mImpl->mJobScheduler.reset();
     mImpl->mThreadPoolExecutor->destroy();
     mImpl->mThreadPoolExecutor.reset();
+    mImpl->mPlayerNameCache.reset(); // 线程池中的查询与预取任务均已结束
     return true;
 }
 
@@ -171,6 +203,8 @@ LandRegistry&       PLand::getLandRegistry() const { return *mImpl->mLandRegistr
 DrawHandleManager*  PLand::getDrawHandleManager() const { return mImpl->mDrawHandleManager.get(); }
 
 ll::thread::ThreadPoolExecutor* PLand::getThreadPool() const { return mImpl->mThreadPoolExecutor.get(); }
+JobScheduler*                   PLand::getJobScheduler() const { return mImpl->mJobScheduler.get(); }
+PlayerNameCache*                PLand::getPlayerNameCache() const { return mImpl->mPlayerNameCache.get(); }
 service::ServiceLocator&        PLand::getServiceLocator() const { return *mImpl->mServiceLocator; }
 
 #ifdef LD_DEVTOOL
@@ -49,6 +49,8 @@ class PLand {
     LDNDAPI class DrawHandleManager* getDrawHandleManager() const;
 
     LDNDAPI ll::thread::ThreadPoolExecutor* getThreadPool() const;
+    LDNDAPI class JobScheduler*             getJobScheduler() const;
+    LDNDAPI class PlayerNameCache*          getPlayerNameCache() const;
 
     LDNDAPI service::ServiceLocator& getServiceLocator() const;
 
@@ -1,6 +1,8 @@
 #include "pland/aabb/LandAABB.h"
 #include "mc/deps/core/math/Vec3.h"
 
+#include <algorithm>
+
 
 namespace land {
 
@@ -57,47 +59,152 @@ std::unordered_set<ChunkPos> LandAABB::getChunks() const {
 }
 
 std::vector<BlockPos> LandAABB::getBorder() const {
+    auto                  points = borderPoints();
     std::vector<BlockPos> border;
-    for (int x = min.x; x <= max.x; ++x) {
-        border.emplace_back(x, min.y, min.z);
-        border.emplace_back(x, min.y, max.z);
-        border.emplace_back(x, max.y, min.z);
-        border.emplace_back(x, max.y, max.z);
-    }
-    for (int y = min.y + 1; y < max.y; ++y) {
-        border.emplace_back(min.x, y, min.z);
-        border.emplace_back(min.x, y, max.z);
-        border.emplace_back(max.x, y, min.z);
-        border.emplace_back(max.x, y, max.z);
-    }
-    for (int z = min.z + 1; z < max.z; ++z) {
-        border.emplace_back(min.x, min.y, z);
-        border.emplace_back(min.x, max.y, z);
-        border.emplace_back(max.x, min.y, z);
-        border.emplace_back(max.x, max.y, z);
-    }
-    for (int y = min.y; y <= max.y; ++y) {
-        border.emplace_back(min.x, y, min.z);
-        border.emplace_back(min.x, y, max.z);
-        border.emplace_back(max.x, y, min.z);
-        border.emplace_back(max.x, y, max.z);
+    for (auto const& pos : points) {
+        border.push_back(pos);
     }
     return border;
 }
 
 std::vector<BlockPos> LandAABB::getRange() const {
+    auto                  points = rangePoints();
     std::vector<BlockPos> range;
-    for (int x = min.x; x <= max.x; ++x) {
-        range.emplace_back(x, max.y, min.z);
-        range.emplace_back(x, max.y, max.z);
-    }
-    for (int z = min.z + 1; z < max.z; ++z) {
-        range.emplace_back(min.x, max.y, z);
-        range.emplace_back(max.x, max.y, z);
+    for (auto const& pos : points) {
+        range.push_back(pos);
     }
     return range;
 }
 
+namespace {
+// 各轴去重后的坐标取值，topFaceOnly 时 Y 轴仅取顶面
+struct AxisValues {
+    std::array<int, 2> values{};
+    size_t             size{0};
+
+    AxisValues(int lo, int hi) : values{lo, hi}, size(lo == hi ? 1 : 2) {}
+    explicit AxisValues(int only) : values{only, only}, size(1) {}
+
+    auto begin() const { return values.begin(); }
+    auto end() const { return values.begin() + static_cast<std::ptrdiff_t>(size); }
+};
+
+void buildOutline(LandAABB const& aabb, bool topFaceOnly, LandAABB::CornerList* corners, LandAABB::EdgeList* edges) {
+    auto const& min = aabb.min;
+    auto const& max = aabb.max;
+
+    AxisValues xs{min.x, max.x};
+    AxisValues ys = topFaceOnly ? AxisValues{max.y} : AxisValues{min.y, max.y};
+    AxisValues zs{min.z, max.z};
+
+    if (corners) {
+        for (int x : xs) {
+            for (int y : ys) {
+                for (int z : zs) corners->push(BlockPos{x, y, z});
+            }
+        }
+    }
+    if (!edges) {
+        return;
+    }
+    // 只有跨度不为 0 的轴才有边线，退化轴上的重复边线自然被去除
+    if (xs.size == 2) {
+        for (int y : ys) {
+            for (int z : zs) edges->push({BlockPos{min.x, y, z}, BlockPos{max.x, y, z}});
+        }
+    }
+    if (ys.size == 2) {
+        for (int x : xs) {
+            for (int z : zs) edges->push({BlockPos{x, min.y, z}, BlockPos{x, max.y, z}});
+        }
+    }
+    if (zs.size == 2) {
+        for (int x : xs) {
+            for (int y : ys) edges->push({BlockPos{x, y, min.z}, BlockPos{x, y, max.z}});
+        }
+    }
+}
+
+int& axisOf(BlockPos& pos, int axis) { return axis == 0 ? pos.x : axis == 1 ? pos.y : pos.z; }
+
+int edgeAxis(LandAABB::Edge const& edge) {
+    if (edge.first.x != edge.second.x) return 0;
+    if (edge.first.y != edge.second.y) return 1;
+    return 2;
+}
+} // namespace
+
+LandAABB::CornerList LandAABB::corners() const {
+    CornerList list;
+    buildOutline(*this, false, &list, nullptr);
+    return list;
+}
+
+LandAABB::EdgeList LandAABB::edges() const {
+    EdgeList list;
+    buildOutline(*this, false, nullptr, &list);
+    return list;
+}
+
+LandAABB::PointRange LandAABB::borderPoints(int stride) const {
+    CornerList corners;
+    EdgeList   edges;
+    buildOutline(*this, false, &corners, &edges);
+    return PointRange{corners, edges, stride};
+}
+
+LandAABB::PointRange LandAABB::rangePoints(int stride) const {
+    CornerList corners;
+    EdgeList   edges;
+    buildOutline(*this, true, &corners, &edges);
+    return PointRange{corners, edges, stride};
+}
+
+LandAABB::PointRange::PointRange(CornerList const& corners, EdgeList const& edges, int stride)
+: mCorners(corners),
+  mEdges(edges),
+  mStride(std::max(stride, 1)) {}
+
+LandAABB::PointRange::Iterator::Iterator(PointRange const& range) : mRange(&range) {
+    mCurrent = range.mCorners.data[0]; // 角点至少有一个
+}
+
+void LandAABB::PointRange::Iterator::_advance() {
+    if (!mRange) {
+        return;
+    }
+    // 角点阶段
+    if (mCorner < mRange->mCorners.size) {
+        if (++mCorner < mRange->mCorners.size) {
+            mCurrent = mRange->mCorners.data[mCorner];
+            return;
+        }
+        mEdge   = 0;
+        mInEdge = false;
+    }
+    // 边线内部点阶段(不含两端角点)
+    while (mEdge < mRange->mEdges.size) {
+        auto const& edge = mRange->mEdges.data[mEdge];
+        int         axis = edgeAxis(edge);
+        auto        from = edge.first;
+        auto        to   = edge.second;
+        int         lo   = axisOf(from, axis);
+        int         hi   = axisOf(to, axis);
+
+        int next = (mInEdge ? mCursor : lo) + mRange->mStride;
+        if (next < hi) {
+            mInEdge                = true;
+            mCursor                = next;
+            mCurrent               = from;
+            axisOf(mCurrent, axis) = next;
+            return;
+        }
+        ++mEdge;
+        mInEdge = false;
+    }
+    mRange = nullptr; // 结束
+}
+
 std::array<Vec3, 4> LandAABB::getVertices() const {
     return {
         min.as(), // 左下
@@ -3,6 +3,11 @@
 #include "pland/Global.h"
 #include "pland/aabb/LandPos.h"
 
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
 namespace land {
 
 
@@ -13,6 +18,74 @@ class LandAABB {
 public:
     LandPos min{}, max{};
 
+    /**
+     * @brief 定长内联列表(无堆分配)
+     */
+    template <typename T, size_t N>
+    struct InplaceList {
+        std::array<T, N> data{};
+        size_t           size{0};
+
+        void push(T const& value) { data[size++] = value; }
+
+        auto begin() const { return data.begin(); }
+        auto end() const { return data.begin() + static_cast<std::ptrdiff_t>(size); }
+        bool empty() const { return size == 0; }
+    };
+
+    using Edge       = std::pair<BlockPos, BlockPos>; // first 在轴向上始终为较小端
+    using CornerList = InplaceList<BlockPos, 8>;
+    using EdgeList   = InplaceList<Edge, 12>;
+
+    /**
+     * @brief 惰性边框点序列，先输出角点，再按步长输出各边线内部点，不产生重复点
+     */
+    class PointRange {
+        CornerList mCorners;
+        EdgeList   mEdges;
+        int        mStride;
+
+    public:
+        class Iterator {
+            PointRange const* mRange{nullptr};
+            size_t            mCorner{0}; // 角点游标
+            size_t            mEdge{0};   // 边线游标
+            int               mCursor{0}; // 边线内部游标(轴向坐标)
+            bool              mInEdge{false};
+            BlockPos          mCurrent{};
+
+            LDAPI void _advance();
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = BlockPos;
+            using difference_type   = std::ptrdiff_t;
+
+            Iterator() = default;
+            LDAPI explicit Iterator(PointRange const& range);
+
+            BlockPos const& operator*() const { return mCurrent; }
+            BlockPos const* operator->() const { return &mCurrent; }
+
+            Iterator& operator++() {
+                _advance();
+                return *this;
+            }
+            void operator++(int) { _advance(); }
+
+            bool operator==(std::default_sentinel_t) const { return mRange == nullptr; }
+        };
+
+        LDAPI explicit PointRange(CornerList const& corners, EdgeList const& edges, int stride);
+
+        Iterator                begin() const { return Iterator{*this}; }
+        std::default_sentinel_t end() const { return {}; }
+
+        [[nodiscard]] CornerList const& corners() const { return mCorners; }
+        [[nodiscard]] EdgeList const&   edges() const { return mEdges; }
+        [[nodiscard]] int               stride() const { return mStride; }
+    };
+
     LDNDAPI static LandAABB make(BlockPos const& min, BlockPos const& max);
 
     LDAPI void fix(); // fix min/max
@@ -103,6 +176,28 @@ class LandAABB {
      */
     LDNDAPI std::vector<std::pair<BlockPos, BlockPos>> getEdges() const;
 
+    /**
+     * @brief 获取去重后的角点(最多 8 个，退化的 AABB 角点更少)
+     */
+    LDNDAPI CornerList corners() const;
+
+    /**
+     * @brief 获取去重后的边线(最多 12 条，不包含零长度边线)
+     */
+    LDNDAPI EdgeList edges() const;
+
+    /**
+     * @brief 惰性遍历立方体边框点，等价于 getBorder() 但不分配内存且无重复点
+     * @param stride 边线内部点采样步长(>=1)，角点总是输出
+     */
+    LDNDAPI PointRange borderPoints(int stride = 1) const;
+
+    /**
+     * @brief 惰性遍历顶面矩形边框点，等价于 getRange() 但不分配内存且无重复点
+     * @param stride 边线内部点采样步长(>=1)，角点总是输出
+     */
+    LDNDAPI PointRange rangePoints(int stride = 1) const;
+
     LDNDAPI bool hasPos(BlockPos const& pos, bool includeY = true) const;
 
     /**
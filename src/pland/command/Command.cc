@@ -10,8 +10,12 @@
 #include "pland/gui/LandManagerGUI.h"
 #include "pland/gui/LandOperatorManagerGUI.h"
 #include "pland/gui/NewLandGUI.h"
+#include "pland/hooks/EventTrace.h"
+#include "pland/hooks/ListenerStats.h"
 #include "pland/infra/Config.h"
 #include "pland/infra/DataConverter.h"
+#include "pland/infra/JobScheduler.h"
+#include "pland/infra/PlayerNameCache.h"
 #include "pland/land/LandRegistry.h"
 #include "pland/selector/SelectorManager.h"
 #include "pland/service/LandManagementService.h"
@@ -27,7 +31,7 @@
 #include "ll/api/i18n/I18n.h"
 #include "ll/api/io/Logger.h"
 #include "ll/api/service/Bedrock.h"
-#include "ll/api/service/PlayerInfo.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
 
 
 #include "mc/deps/core/math/Color.h"
@@ -132,15 +136,8 @@ static auto const ListOperator = [](CommandOrigin const& ori, CommandOutput& out
 
     std::ostringstream oss;
     oss << "管理员: "_tr();
-    auto& infoDb = ll::service::PlayerInfo::getInstance();
-    for (auto& oper : operators) {
-        auto info = infoDb.fromUuid(oper);
-        if (info) {
-            oss << info->name;
-        } else {
-            oss << oper.asString();
-        }
-        oss << " | ";
+    for (auto& name : PLand::getInstance().getPlayerNameCache()->resolve(operators)) {
+        oss << name << " | ";
     }
     feedback_utils::sendText(out, oss.str());
     return;
@@ -225,19 +222,21 @@ static auto const Reload = [](CommandOrigin const& ori, CommandOutput& out) {
 };
 
 
-enum class DrawType : int { Disable = 0, NearLand, CurrentLand };
+enum class DrawType : int { Disable = 0, NearLand, CurrentLand, FollowNearLand };
 struct DrawParam {
     DrawType type;
 };
 static auto const Draw = [](CommandOrigin const& ori, CommandOutput& out, DrawParam const& param) {
     CHECK_TYPE(ori, out, CommandOriginType::Player);
 
-    auto& player = *static_cast<Player*>(ori.getEntity());
-    auto& db     = PLand::getInstance().getLandRegistry();
-    auto  handle = PLand::getInstance().getDrawHandleManager()->getOrCreateHandle(player);
+    auto& player  = *static_cast<Player*>(ori.getEntity());
+    auto& db      = PLand::getInstance().getLandRegistry();
+    auto  manager = PLand::getInstance().getDrawHandleManager();
+    auto  handle  = manager->getOrCreateHandle(player);
 
     switch (param.type) {
     case DrawType::Disable: {
+        manager->disableFollow(player);
         handle->clearLand();
         feedback_utils::sendText(out, "领地绘制已关闭"_trf(player));
         break;
@@ -260,6 +259,12 @@ static auto const Draw = [](CommandOrigin const& ori, CommandOutput& out, DrawPa
         feedback_utils::sendText(out, "已绘制附近 {} 个领地"_trf(player, lands.size()));
         break;
     }
+
+    case DrawType::FollowNearLand: {
+        manager->enableFollow(player);
+        feedback_utils::sendText(out, "已开启附近领地跟随绘制，使用 /pland draw disable 关闭"_trf(player));
+        break;
+    }
     }
 };
 
@@ -285,11 +290,27 @@ static auto const Import = [](CommandOrigin const& ori, CommandOutput& out, Impo
         return;
     }
 
-    if (iLandConverter(param.relationship_file, param.data_file, param.clearDb).execute()) {
-        out.success("导入成功"_tr());
-    } else {
-        out.error("导入失败"_tr());
+    // 文件解析在后台任务中执行，转换与写入注册表回到服务器线程，结果输出到日志
+    auto converter = std::make_shared<iLandConverter>(param.relationship_file, param.data_file, param.clearDb);
+    auto job       = PLand::getInstance().getJobScheduler()->submit("iLandConverter", [converter]() {
+        if (!converter->parse()) {
+            PLand::getInstance().getSelf().getLogger().error("导入失败"_tr());
+            return;
+        }
+        ll::thread::ServerThreadExecutor::getDefault().execute([converter]() {
+            auto& logger = PLand::getInstance().getSelf().getLogger();
+            if (converter->apply()) {
+                logger.info("导入成功"_tr());
+            } else {
+                logger.error("导入失败"_tr());
+            }
+        });
+    });
+    if (!job) {
+        out.error("提交导入任务失败: {}"_tr(job.error().message()));
+        return;
     }
+    out.success("导入任务已提交，完成后将在日志中输出结果"_tr());
 };
 
 static auto const SetLandTeleportPos = [](CommandOrigin const& ori, CommandOutput& out) {
@@ -376,6 +397,195 @@ static auto const This = [](CommandOrigin const& ori, CommandOutput& out) {
     LandManagerGUI::sendMainMenu(player, land);
 };
 
+
+enum class StatsAction : int { Show = 0, On, Off, Reset, Dump };
+struct StatsParam {
+    StatsAction action = StatsAction::Show;
+};
+static auto const Stats = [](CommandOrigin const& ori, CommandOutput& out, StatsParam const& param) {
+    CHECK_TYPE(ori, out, CommandOriginType::DedicatedServer);
+
+    switch (param.action) {
+    case StatsAction::Show: {
+        if (!ListenerStats::isCalibrated()) {
+            feedback_utils::sendErrorText(out, "监听器统计正在校准计时器，请稍后重试"_tr());
+            return;
+        }
+        auto snapshots = ListenerStats::collect();
+        std::erase_if(snapshots, [](ListenerStats::Snapshot const& s) { return s.calls == 0; });
+        if (snapshots.empty()) {
+            feedback_utils::sendErrorText(out, "暂无监听器统计数据，使用 /pland stats on 开启统计"_tr());
+            return;
+        }
+
+        std::ostringstream oss;
+        oss << "监听器统计(耗时单位: 微秒，统计状态: {})"_tr(ListenerStats::isEnabled() ? "on" : "off") << "\n";
+        oss << "name | calls | pass | skip | cancel | total | mean | p50 | p90 | p99 | max\n";
+        auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+        for (auto const& s : snapshots) {
+            oss << fmt::format(
+                "{} | {} | {} | {} | {} | {:.1f} | {:.2f} | {:.2f} | {:.2f} | {:.2f} | {:.2f}\n",
+                s.name,
+                s.calls,
+                s.pass,
+                s.skip,
+                s.cancel,
+                us(s.totalNs),
+                us(s.meanNs),
+                us(s.p50Ns),
+                us(s.p90Ns),
+                us(s.p99Ns),
+                us(s.maxNs)
+            );
+        }
+        feedback_utils::sendText(out, oss.str());
+        break;
+    }
+
+    case StatsAction::On: {
+        ListenerStats::setEnabled(true);
+        feedback_utils::sendText(out, "监听器统计已开启"_tr());
+        break;
+    }
+
+    case StatsAction::Off: {
+        ListenerStats::setEnabled(false);
+        feedback_utils::sendText(out, "监听器统计已关闭"_tr());
+        break;
+    }
+
+    case StatsAction::Reset: {
+        ListenerStats::reset();
+        feedback_utils::sendText(out, "监听器统计已重置"_tr());
+        break;
+    }
+
+    case StatsAction::Dump: {
+        auto path = ListenerStats::dump();
+        if (!path) {
+            feedback_utils::sendErrorText(out, "导出监听器统计失败: {}"_tr(path.error().message()));
+            return;
+        }
+        feedback_utils::sendText(out, "监听器统计已导出到 {}"_tr(path->string()));
+        break;
+    }
+    }
+};
+
+
+enum class TraceAction : int { Dump = 0, Clear };
+struct TraceParam {
+    TraceAction action;
+};
+static auto const Trace = [](CommandOrigin const& ori, CommandOutput& out, TraceParam const& param) {
+    CHECK_TYPE(ori, out, CommandOriginType::DedicatedServer);
+
+    switch (param.action) {
+    case TraceAction::Dump: {
+        auto path = EventTrace::dump();
+        if (!path) {
+            feedback_utils::sendErrorText(out, "导出事件追踪失败: {}"_tr(path.error().message()));
+            return;
+        }
+        feedback_utils::sendText(out, "事件追踪已导出到 {}"_tr(path->string()));
+        break;
+    }
+
+    case TraceAction::Clear: {
+        EventTrace::clear();
+        feedback_utils::sendText(out, "事件追踪缓冲区已清空"_tr());
+        break;
+    }
+    }
+};
+
+static auto const Jobs = [](CommandOrigin const& ori, CommandOutput& out) {
+    CHECK_TYPE(ori, out, CommandOriginType::DedicatedServer);
+
+    auto scheduler = PLand::getInstance().getJobScheduler();
+
+    std::ostringstream oss;
+    oss << "后台任务统计(耗时单位: 毫秒，并发上限: {})"_tr(scheduler->getConcurrency()) << "\n";
+    oss << "priority | depth | submitted | completed | cancelled | expired | rejected | mean | max\n";
+    auto ms = [](uint64_t ns) { return static_cast<double>(ns) / 1'000'000.0; };
+    for (auto const& s : scheduler->getStats()) {
+        oss << fmt::format(
+            "{} | {} | {} | {} | {} | {} | {} | {:.2f} | {:.2f}\n",
+            magic_enum::enum_name(s.priority),
+            s.depth,
+            s.submitted,
+            s.completed,
+            s.cancelled,
+            s.expired,
+            s.rejected,
+            ms(s.meanRunNs),
+            ms(s.maxRunNs)
+        );
+    }
+    if (auto manager = PLand::getInstance().getDrawHandleManager()) {
+        auto& packets = manager->getPacketScheduler();
+        auto& stats   = packets.getStats();
+        oss << "绘制数据包: 已发送 {} | 延后 {} | 丢弃 {} | 待发送 {}"_tr(
+            stats.sent,
+            stats.deferred,
+            stats.dropped,
+            packets.getPendingCount()
+        ) << "\n";
+    }
+    feedback_utils::sendText(out, oss.str());
+};
+
+struct SearchParam {
+    std::string keyword;
+    int         page{1};
+};
+static auto const Search = [](CommandOrigin const& ori, CommandOutput& out, SearchParam const& param) {
+    CHECK_TYPE(ori, out, CommandOriginType::DedicatedServer);
+    static constexpr size_t PageSize = 10;
+
+    if (param.page < 1) {
+        feedback_utils::sendErrorText(out, "页码必须大于 0"_tr());
+        return;
+    }
+    auto& registry = PLand::getInstance().getLandRegistry();
+    auto  result   = registry.fuzzySearchLands(param.keyword, (param.page - 1) * PageSize, PageSize);
+    if (result.total == 0) {
+        feedback_utils::sendErrorText(out, "未找到名称匹配 \"{}\" 的领地"_tr(param.keyword));
+        return;
+    }
+
+    auto totalPages = (result.total + PageSize - 1) / PageSize;
+
+    std::ostringstream oss;
+    oss << "领地搜索 \"{}\": 共 {} 个结果 (第 {}/{} 页)"_tr(param.keyword, result.total, param.page, totalPages) << "\n";
+    oss << "id | name | dimension | score\n";
+    for (auto const& match : result.matches) {
+        if (auto land = registry.getLand(match.id)) {
+            oss << fmt::format(
+                "{} | {} | {} | {:.2f}\n",
+                land->getId(),
+                land->getName(),
+                land->getDimensionId(),
+                match.score
+            );
+        }
+    }
+    feedback_utils::sendText(out, oss.str());
+};
+
+struct TraceSampleParam {
+    int rate;
+};
+static auto const TraceSample = [](CommandOrigin const& ori, CommandOutput& out, TraceSampleParam const& param) {
+    CHECK_TYPE(ori, out, CommandOriginType::DedicatedServer);
+    if (param.rate < 0) {
+        feedback_utils::sendErrorText(out, "采样率不能为负数"_tr());
+        return;
+    }
+    EventTrace::setSampleRate(static_cast<uint32_t>(param.rate));
+    feedback_utils::sendText(out, "事件追踪采样率已设置为 {} (0 为关闭)"_tr(param.rate));
+};
+
 }; // namespace Lambda
 
 
@@ -415,7 +625,7 @@ bool LandCommand::setup() {
     // pland buy 购买
     cmd.overload().text("buy").execute(Lambda::Buy);
 
-    // pland draw <disable|near|current> 开启/关闭领地绘制
+    // pland draw <disable|near|current|follow> 开启/关闭领地绘制
     if (Config::cfg.land.setupDrawCommand) {
         cmd.overload<Lambda::DrawParam>().text("draw").required("type").execute(Lambda::Draw);
     }
@@ -434,6 +644,21 @@ bool LandCommand::setup() {
     // pland set language 设置语言
     cmd.overload().text("set").text("language").execute(Lambda::SetLanguage);
 
+    // pland stats [show|on|off|reset|dump] 监听器性能统计
+    cmd.overload<Lambda::StatsParam>().text("stats").optional("action").execute(Lambda::Stats);
+
+    // pland jobs 后台任务统计
+    cmd.overload().text("jobs").execute(Lambda::Jobs);
+
+    // pland search <keyword> [page] 按名称模糊搜索领地
+    cmd.overload<Lambda::SearchParam>().text("search").required("keyword").optional("page").execute(Lambda::Search);
+
+    // pland trace <dump|clear> 导出/清空事件追踪
+    cmd.overload<Lambda::TraceParam>().text("trace").required("action").execute(Lambda::Trace);
+
+    // pland trace sample <rate> 设置事件追踪采样率
+    cmd.overload<Lambda::TraceSampleParam>().text("trace").text("sample").required("rate").execute(Lambda::TraceSample);
+
 #ifdef LD_DEVTOOL
     // pland devtool
     if (Config::cfg.internal.devTools) {
@@ -4,7 +4,19 @@
 #include "impl/DefaultParticleHandle.h"
 #include "mc/world/actor/player/Player.h"
 #include "pland/PLand.h"
+#include "pland/aabb/LandAABB.h"
 #include "pland/infra/Config.h"
+#include "pland/land/Land.h"
+#include "pland/land/LandRegistry.h"
+
+#include "ll/api/chrono/GameChrono.h"
+#include "ll/api/coro/CoroTask.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
+
+#include "mc/deps/core/math/Color.h"
+
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 
@@ -29,16 +41,32 @@ DrawHandleManager::DrawHandleManager() {
     default:
         break;
     }
+
+    mCoroStop           = std::make_shared<std::atomic<bool>>(false);
+    mInterruptableSleep = std::make_shared<ll::coro::InterruptableSleep>();
+    ll::coro::keepThis([sleep = mInterruptableSleep, stop = mCoroStop, this]() -> ll::coro::CoroTask<> {
+        while (!stop->load()) {
+            co_await sleep->sleepFor(ll::chrono::ticks(10));
+            if (stop->load()) {
+                break;
+            }
+            _tickFollowers();
+        }
+        co_return;
+    }).launch(ll::thread::ServerThreadExecutor::getDefault());
 }
 
-DrawHandleManager::~DrawHandleManager() = default;
+DrawHandleManager::~DrawHandleManager() {
+    mCoroStop->store(true);
+    mInterruptableSleep->interrupt(true);
+}
 
-std::unique_ptr<drawer::IDrawerHandle> DrawHandleManager::createHandle() const {
+std::unique_ptr<drawer::IDrawerHandle> DrawHandleManager::createHandle() {
     switch (Config::cfg.land.drawHandleBackend) {
     case DrawerType::DefaultParticle:
-        return std::make_unique<drawer::detail::DefaultParticleHandle>();
+        return std::make_unique<drawer::detail::DefaultParticleHandle>(mGeometryCache, mPacketScheduler);
     case DrawerType::DebugShape:
-        return std::make_unique<drawer::detail::DebugShapeHandle>();
+        return std::make_unique<drawer::detail::DebugShapeHandle>(mGeometryCache, mPacketScheduler);
     }
     throw std::runtime_error("Unknown drawer type");
 }
@@ -53,9 +81,106 @@ drawer::IDrawerHandle* DrawHandleManager::getOrCreateHandle(Player& player) {
     return iter->second.get();
 }
 
-void DrawHandleManager::removeHandle(Player& player) { mDrawHandles.erase(player.getUuid()); }
+void DrawHandleManager::removeHandle(Player& player) {
+    mFollowers.erase(player.getUuid());
+    mDrawHandles.erase(player.getUuid());
+    mGeometryCache.purge();
+}
+
+void DrawHandleManager::removeAllHandle() {
+    mFollowers.clear();
+    mDrawHandles.clear();
+    mGeometryCache.purge();
+}
+
+void DrawHandleManager::invalidateLandGeometry(std::shared_ptr<Land> const& land) {
+    mGeometryCache.invalidate(land->getId());
+    for (auto& [uuid, handle] : mDrawHandles) {
+        handle->refresh(land);
+    }
+}
+
+drawer::LandGeometryCache& DrawHandleManager::getGeometryCache() { return mGeometryCache; }
+
+drawer::PacketScheduler& DrawHandleManager::getPacketScheduler() { return mPacketScheduler; }
+
+void DrawHandleManager::enableFollow(Player& player) {
+    auto iter =
+        mFollowers.try_emplace(player.getUuid(), std::max(Config::cfg.land.drawFollow.updateInterval, 0)).first;
+    iter->second.mNeedUpdate = true;
+    _updateFollower(player, *getOrCreateHandle(player), iter->second);
+}
+
+void DrawHandleManager::disableFollow(Player& player) { mFollowers.erase(player.getUuid()); }
+
+bool DrawHandleManager::isFollowing(Player& player) const { return mFollowers.contains(player.getUuid()); }
 
-void DrawHandleManager::removeAllHandle() { mDrawHandles.clear(); }
+void DrawHandleManager::_tickFollowers() {
+    auto iter = mFollowers.begin();
+    while (iter != mFollowers.end()) {
+        auto handleIter = mDrawHandles.find(iter->first);
+        if (handleIter == mDrawHandles.end()) {
+            iter = mFollowers.erase(iter); // 句柄已移除
+            continue;
+        }
+        auto& handle = *handleIter->second;
+        if (auto player = handle.getTargetPlayer()) {
+            _updateFollower(*player, handle, iter->second);
+        }
+        ++iter;
+    }
+}
+
+void DrawHandleManager::_updateFollower(Player& player, drawer::IDrawerHandle& handle, FollowState& state) {
+    auto const& cfg   = Config::cfg.land;
+    auto        pos   = BlockPos{player.getPosition()};
+    int         dimId = player.getDimensionId().id;
+
+    if (!state.mNeedUpdate) {
+        // 未跨维度且移动距离未超过阈值时不重新计算
+        if (dimId == state.mLastDimId) {
+            auto dx        = pos.x - state.mLastPos.x;
+            auto dy        = pos.y - state.mLastPos.y;
+            auto dz        = pos.z - state.mLastPos.z;
+            auto threshold = cfg.drawFollow.moveThreshold;
+            if (dx * dx + dy * dy + dz * dz < threshold * threshold) {
+                return;
+            }
+        }
+        if (!state.mDebouncer.ready()) {
+            return;
+        }
+    }
+    state.mNeedUpdate = false;
+    state.mLastPos    = pos;
+    state.mLastDimId  = dimId;
+
+    // 粒子后端超出可视距离的边线不会发送，绘制半径不必超过可视距离
+    int radius = cfg.drawRange;
+    if (cfg.drawHandleBackend == DrawerType::DefaultParticle) {
+        radius = std::min(radius, cfg.particleDrawer.viewDistance);
+    }
+
+    auto range = LandAABB{
+        LandPos{pos.x - radius, pos.y - radius, pos.z - radius},
+        LandPos{pos.x + radius, pos.y + radius, pos.z + radius}
+    };
+    auto lands = PLand::getInstance().getLandRegistry().getLandsIntersecting(range, dimId);
+
+    // 只发送增量(句柄对已绘制的领地不会重复发送，被调度器丢弃的领地在此重新投递)
+    std::unordered_set<LandID> current;
+    current.reserve(lands.size());
+    for (auto& land : lands) {
+        current.insert(land->getId());
+        handle.draw(land, mce::Color::WHITE());
+    }
+    for (auto id : state.mLands) {
+        if (!current.contains(id)) {
+            handle.remove(id);
+        }
+    }
+    state.mLands = std::move(current);
+}
 
 
 } // namespace land
@@ -1,19 +1,48 @@
 #pragma once
+#include "LandGeometryCache.h"
+#include "PacketScheduler.h"
 #include "impl/IDrawerHandle.h"
 #include "pland/Global.h"
+#include "pland/infra/Debouncer.h"
 
+#include "ll/api/coro/InterruptableSleep.h"
+
+#include "mc/world/level/BlockPos.h"
+
+#include <atomic>
 #include <complex.h>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 class Player;
 
 namespace land {
 
 class DrawHandleManager final {
+    // 跟随绘制状态
+    struct FollowState {
+        std::unordered_set<LandID> mLands;            // 已绘制的领地
+        BlockPos                   mLastPos{};        // 上次计算时的位置
+        int                        mLastDimId{-1};    // 上次计算时的维度
+        Debouncer                  mDebouncer;        // 更新限流
+        bool                       mNeedUpdate{true}; // 强制更新
+
+        explicit FollowState(int intervalMs) : mDebouncer(intervalMs) {}
+    };
+
+    drawer::LandGeometryCache                                             mGeometryCache;   // 共享领地几何缓存
+    drawer::PacketScheduler                                               mPacketScheduler; // 绘制数据包调度
     std::unordered_map<mce::UUID, std::unique_ptr<drawer::IDrawerHandle>> mDrawHandles;
+    std::unordered_map<mce::UUID, FollowState>                            mFollowers; // 跟随绘制的玩家
+    std::shared_ptr<std::atomic<bool>>                                    mCoroStop{nullptr};
+    std::shared_ptr<ll::coro::InterruptableSleep>                         mInterruptableSleep{nullptr};
+
+    std::unique_ptr<drawer::IDrawerHandle> createHandle();
+
+    void _tickFollowers();
 
-    std::unique_ptr<drawer::IDrawerHandle> createHandle() const;
+    void _updateFollower(Player& player, drawer::IDrawerHandle& handle, FollowState& state);
 
 public:
     LD_DISABLE_COPY_AND_MOVE(DrawHandleManager);
@@ -26,6 +55,27 @@ class DrawHandleManager final {
     LDAPI void removeHandle(Player& player);
 
     LDAPI void removeAllHandle();
+
+    /**
+     * @brief 领地范围变更，使共享几何体失效并通知所有句柄重新绘制
+     */
+    LDAPI void invalidateLandGeometry(std::shared_ptr<Land> const& land);
+
+    LDNDAPI drawer::LandGeometryCache& getGeometryCache();
+
+    LDNDAPI drawer::PacketScheduler& getPacketScheduler();
+
+    /**
+     * @brief 开启跟随绘制，玩家移动时增量绘制/移除附近领地
+     */
+    LDAPI void enableFollow(Player& player);
+
+    /**
+     * @brief 关闭跟随绘制（不清除已绘制的领地）
+     */
+    LDAPI void disableFollow(Player& player);
+
+    LDNDAPI bool isFollowing(Player& player) const;
 };
 
 
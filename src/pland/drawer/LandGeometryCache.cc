@@ -0,0 +1,51 @@
+#include "LandGeometryCache.h"
+
+#include <functional>
+
+
+namespace land::drawer {
+
+
+size_t LandGeometryCache::KeyHash::operator()(Key const& key) const noexcept {
+    size_t seed = std::hash<LandID>{}(key.landId);
+    seed       ^= std::hash<uint64>{}(key.version) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed       ^= std::hash<uint32>{}(key.variant) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed       ^= key.type.hash_code() + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+std::shared_ptr<void> LandGeometryCache::_find(Key const& key) {
+    auto iter = mEntries.find(key);
+    if (iter == mEntries.end()) {
+        return nullptr;
+    }
+    if (auto ptr = iter->second.lock()) {
+        return ptr;
+    }
+    mEntries.erase(iter); // 订阅者已全部释放
+    return nullptr;
+}
+
+uint64 LandGeometryCache::getVersion(LandID landId) const {
+    auto iter = mVersions.find(landId);
+    return iter == mVersions.end() ? 0 : iter->second;
+}
+
+void LandGeometryCache::invalidate(LandID landId) {
+    ++mVersions[landId];
+    std::erase_if(mEntries, [landId](auto const& entry) { return entry.first.landId == landId; });
+}
+
+void LandGeometryCache::purge() {
+    std::erase_if(mEntries, [](auto const& entry) { return entry.second.expired(); });
+}
+
+void LandGeometryCache::clear() {
+    mVersions.clear();
+    mEntries.clear();
+}
+
+size_t LandGeometryCache::size() const { return mEntries.size(); }
+
+
+} // namespace land::drawer
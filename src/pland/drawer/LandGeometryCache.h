@@ -0,0 +1,80 @@
+#pragma once
+#include "pland/Global.h"
+
+#include <cstddef>
+#include <memory>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+
+namespace land::drawer {
+
+
+/**
+ * @brief 领地轮廓几何缓存
+ *
+ * 同一领地的轮廓几何体(粒子边线、DebugShape 形状等)由所有玩家的绘制句柄共享。
+ * 缓存只持有 weak_ptr，句柄持有 shared_ptr 即视为订阅，最后一个订阅者释放后几何体随之销毁。
+ * 领地范围变更后通过 invalidate() 提升版本号，旧版本几何体不再被命中。
+ *
+ * @note 非线程安全，仅在服务器线程使用
+ */
+class LandGeometryCache final {
+    struct Key {
+        LandID          landId;
+        uint64          version;
+        uint32          variant; // 同一领地的不同变体(例如颜色)
+        std::type_index type;
+
+        bool operator==(Key const& other) const = default;
+    };
+    struct KeyHash {
+        size_t operator()(Key const& key) const noexcept;
+    };
+
+    std::unordered_map<LandID, uint64>                    mVersions; // 领地几何版本
+    std::unordered_map<Key, std::weak_ptr<void>, KeyHash> mEntries;
+
+    std::shared_ptr<void> _find(Key const& key);
+
+public:
+    LD_DISABLE_COPY_AND_MOVE(LandGeometryCache);
+    explicit LandGeometryCache() = default;
+
+    [[nodiscard]] uint64 getVersion(LandID landId) const;
+
+    /**
+     * @brief 获取或创建领地几何体
+     * @param factory 未命中时调用，返回 std::shared_ptr<T>
+     */
+    template <typename T, typename Factory>
+    [[nodiscard]] std::shared_ptr<T> acquire(LandID landId, uint32 variant, Factory&& factory) {
+        auto key = Key{landId, getVersion(landId), variant, std::type_index(typeid(T))};
+        if (auto cached = _find(key)) {
+            return std::static_pointer_cast<T>(cached);
+        }
+        std::shared_ptr<T> geometry = std::forward<Factory>(factory)();
+        if (geometry) {
+            mEntries[key] = geometry;
+        }
+        return geometry;
+    }
+
+    /**
+     * @brief 使领地几何体失效(领地范围变更)
+     */
+    void invalidate(LandID landId);
+
+    /**
+     * @brief 清理已无订阅者的缓存项
+     */
+    void purge();
+
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+};
+
+
+} // namespace land::drawer
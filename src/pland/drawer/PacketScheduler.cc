@@ -0,0 +1,165 @@
+#include "PacketScheduler.h"
+#include "impl/IDrawerHandle.h"
+#include "pland/infra/Config.h"
+
+#include "ll/api/chrono/GameChrono.h"
+#include "ll/api/coro/CoroTask.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
+
+#include "mc/world/actor/player/Player.h"
+
+#include <algorithm>
+
+
+namespace land::drawer {
+
+
+PacketScheduler::PacketScheduler() {
+    mCoroStop           = std::make_shared<std::atomic<bool>>(false);
+    mInterruptableSleep = std::make_shared<ll::coro::InterruptableSleep>();
+    ll::coro::keepThis([sleep = mInterruptableSleep, stop = mCoroStop, this]() -> ll::coro::CoroTask<> {
+        while (!stop->load()) {
+            co_await sleep->sleepFor(ll::chrono::ticks(1));
+            if (stop->load()) {
+                break;
+            }
+            _tick();
+        }
+        co_return;
+    }).launch(ll::thread::ServerThreadExecutor::getDefault());
+}
+
+PacketScheduler::~PacketScheduler() {
+    mCoroStop->store(true);
+    mInterruptableSleep->interrupt(true);
+}
+
+void PacketScheduler::_tick() {
+    ++mTick;
+    if (mOrder.empty()) {
+        return;
+    }
+    auto const& cfg = Config::cfg.land.drawScheduler;
+
+    int    global = cfg.maxPacketsPerTick;
+    size_t count  = mOrder.size();
+    mRoundRobin  %= count;
+    for (size_t i = 0; i < count && global > 0; ++i) {
+        auto  handle  = mOrder[(mRoundRobin + i) % count];
+        auto& channel = mChannels[handle];
+        auto  player  = handle->getTargetPlayer();
+        if (!player) {
+            auto jobs = std::move(channel.jobs); // 玩家已离线
+            channel.jobs.clear();
+            for (auto const& pending : jobs) {
+                _drop(channel, pending);
+            }
+            continue;
+        }
+
+        int budget = std::min(cfg.maxPacketsPerPlayerPerTick, global);
+        int used   = 0;
+        while (!channel.jobs.empty() && used < budget) {
+            auto pending = std::move(channel.jobs.front());
+            channel.jobs.pop_front();
+            pending.job(*player);
+            used += pending.cost;
+        }
+        if (used < budget && channel.producer) {
+            used += channel.producer(*player, budget - used);
+        }
+        mStats.sent += used;
+        global      -= used;
+    }
+    ++mRoundRobin; // 轮换起点，避免排在后面的玩家长期饥饿
+
+    for (auto& [handle, channel] : mChannels) {
+        for (auto& pending : channel.jobs) {
+            if (!pending.deferred) {
+                pending.deferred = true;
+                ++mStats.deferred;
+            }
+        }
+    }
+}
+
+void PacketScheduler::_drop(Channel& channel, PendingJob const& pending) {
+    ++mStats.dropped;
+    if (pending.key != 0 && channel.onDrop) {
+        channel.onDrop(pending.key);
+    }
+}
+
+void PacketScheduler::attach(IDrawerHandle const& handle, Producer producer, DropHandler onDrop) {
+    auto [iter, inserted] = mChannels.try_emplace(&handle);
+    iter->second.producer = std::move(producer);
+    iter->second.onDrop   = std::move(onDrop);
+    if (inserted) {
+        mOrder.push_back(&handle);
+    }
+}
+
+void PacketScheduler::detach(IDrawerHandle const& handle) {
+    auto iter = mChannels.find(&handle);
+    if (iter == mChannels.end()) {
+        return;
+    }
+    mStats.dropped += iter->second.jobs.size();
+    mChannels.erase(iter);
+    std::erase(mOrder, &handle);
+}
+
+void PacketScheduler::enqueue(IDrawerHandle const& handle, uint64 key, Job job, int cost) {
+    auto iter = mChannels.find(&handle);
+    if (iter == mChannels.end()) {
+        return; // 句柄未注册
+    }
+    auto& channel = iter->second;
+    auto& jobs    = channel.jobs;
+    if (key != 0) {
+        auto exist = std::find_if(jobs.begin(), jobs.end(), [key](PendingJob const& j) { return j.key == key; });
+        if (exist != jobs.end()) {
+            exist->job  = std::move(job); // 合并
+            exist->cost = cost;
+            return;
+        }
+    }
+    jobs.push_back({key, cost, std::move(job), false});
+
+    auto limit = static_cast<size_t>(std::max(Config::cfg.land.drawScheduler.maxQueuedPerPlayer, 1));
+    while (jobs.size() > limit) {
+        auto pending = std::move(jobs.front()); // 丢弃最旧的任务
+        jobs.pop_front();
+        _drop(channel, pending);
+    }
+}
+
+bool PacketScheduler::cancel(IDrawerHandle const& handle, uint64 key) {
+    auto iter = mChannels.find(&handle);
+    if (iter == mChannels.end() || key == 0) {
+        return false;
+    }
+    return std::erase_if(iter->second.jobs, [key](PendingJob const& j) { return j.key == key; }) > 0;
+}
+
+void PacketScheduler::cancelAll(IDrawerHandle const& handle) {
+    auto iter = mChannels.find(&handle);
+    if (iter != mChannels.end()) {
+        iter->second.jobs.clear();
+    }
+}
+
+PacketScheduler::Stats const& PacketScheduler::getStats() const { return mStats; }
+
+uint64 PacketScheduler::getCurrentTick() const { return mTick; }
+
+size_t PacketScheduler::getPendingCount() const {
+    size_t count = 0;
+    for (auto& [handle, channel] : mChannels) {
+        count += channel.jobs.size();
+    }
+    return count;
+}
+
+
+} // namespace land::drawer
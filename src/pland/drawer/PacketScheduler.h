@@ -0,0 +1,117 @@
+#pragma once
+#include "pland/Global.h"
+
+#include "ll/api/coro/InterruptableSleep.h"
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class Player;
+
+namespace land::drawer {
+class IDrawerHandle;
+
+
+/**
+ * @brief 绘制数据包调度器
+ *
+ * 所有绘制句柄的数据包统一经由此调度器发出，每 tick 按全局预算与单玩家预算轮询发送，
+ * 超出预算的部分延后到后续 tick。同一句柄内相同 key 的待发送任务会被合并。
+ *
+ * @note 非线程安全，仅在服务器线程使用
+ */
+class PacketScheduler final {
+public:
+    using Job         = std::function<void(Player&)>;            // 发送任务
+    using Producer    = std::function<int(Player&, int budget)>; // 流式生产者，返回实际发送数量
+    using DropHandler = std::function<void(uint64 key)>;         // 任务被丢弃(未发送)时回调
+
+    struct Stats {
+        uint64 sent{0};     // 已发送
+        uint64 deferred{0}; // 因预算不足被延后(每个任务最多计一次)
+        uint64 dropped{0};  // 因队列溢出或玩家离线被丢弃
+    };
+
+    /**
+     * @brief 生成合并 key，channel 用于区分不同用途的 id
+     */
+    static constexpr uint64 makeKey(uint8_t channel, uint64 id) {
+        return static_cast<uint64>(channel) << 56 | (id & 0x00FF'FFFF'FFFF'FFFF);
+    }
+    static constexpr uint8_t keyChannel(uint64 key) { return static_cast<uint8_t>(key >> 56); }
+    static constexpr uint64  keyId(uint64 key) { return key & 0x00FF'FFFF'FFFF'FFFF; }
+
+private:
+    struct PendingJob {
+        uint64 key;      // 0 表示不合并
+        int    cost;     // 数据包数量
+        Job    job;
+        bool   deferred; // 是否已计入延后
+    };
+    struct Channel {
+        std::deque<PendingJob> jobs;
+        Producer               producer;
+        DropHandler            onDrop;
+    };
+
+    std::unordered_map<IDrawerHandle const*, Channel> mChannels;
+    std::vector<IDrawerHandle const*>                 mOrder;        // 轮询顺序
+    size_t                                            mRoundRobin{0};
+    uint64                                            mTick{0}; // 调度器运行的 tick 数
+    Stats                                             mStats;
+    std::shared_ptr<std::atomic<bool>>                mCoroStop{nullptr};
+    std::shared_ptr<ll::coro::InterruptableSleep>     mInterruptableSleep{nullptr};
+
+    void _tick();
+
+    void _drop(Channel& channel, PendingJob const& pending); // 丢弃任务并通知句柄
+
+public:
+    LD_DISABLE_COPY_AND_MOVE(PacketScheduler);
+    explicit PacketScheduler();
+    ~PacketScheduler();
+
+    /**
+     * @brief 注册句柄，producer 与 onDrop 可为空
+     * @param onDrop 队列溢出或玩家离线导致任务被丢弃时回调，句柄据此撤销对应的绘制记录
+     */
+    void attach(IDrawerHandle const& handle, Producer producer = {}, DropHandler onDrop = {});
+
+    /**
+     * @brief 注销句柄，丢弃其未发送的任务(不回调 onDrop)
+     */
+    void detach(IDrawerHandle const& handle);
+
+    /**
+     * @brief 投递发送任务，key 非 0 时替换队列中相同 key 的任务
+     */
+    void enqueue(IDrawerHandle const& handle, uint64 key, Job job, int cost = 1);
+
+    /**
+     * @brief 取消尚未发送的任务
+     * @return 任务仍在队列中并被取消时返回 true
+     */
+    bool cancel(IDrawerHandle const& handle, uint64 key);
+
+    /**
+     * @brief 取消句柄所有尚未发送的任务
+     */
+    void cancelAll(IDrawerHandle const& handle);
+
+    LDNDAPI Stats const& getStats() const;
+
+    /**
+     * @brief 当前 tick 序号(每 tick 递增，与是否有预算无关)
+     */
+    [[nodiscard]] uint64 getCurrentTick() const;
+
+    LDNDAPI size_t getPendingCount() const;
+};
+
+
+} // namespace land::drawer
@@ -4,7 +4,10 @@
 #include "mc/world/phys/AABB.h"
 #include "pland/Global.h"
 #include "pland/aabb/LandAABB.h"
+#include "pland/drawer/LandGeometryCache.h"
+#include "pland/drawer/PacketScheduler.h"
 #include "pland/land/Land.h"
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <mc/_HeaderOutputPredefine.h>
@@ -111,24 +114,60 @@ inline GeoId allocatedID() {
     return GeoId{next++};
 }
 
+inline uint32 packColor(mce::Color const& color) {
+    auto channel = [](float v) { return static_cast<uint32>(std::clamp(v, 0.0f, 1.0f) * 255.0f); };
+    return channel(color.r) << 24 | channel(color.g) << 16 | channel(color.b) << 8 | channel(color.a);
+}
+
+using SharedBoundsBox = std::shared_ptr<debug_shape::extension::IBoundsBox>;
+
+// 调度器合并 key
+inline constexpr uint8_t ShapeKeyChannel = 1;
+inline constexpr uint8_t LandKeyChannel  = 2;
+
+inline uint64 shapeKey(GeoId id) { return PacketScheduler::makeKey(ShapeKeyChannel, id.value); }
+inline uint64 landKey(LandID id) { return PacketScheduler::makeKey(LandKeyChannel, static_cast<uint64>(id)); }
+
 
 struct DebugShapeHandle::Impl {
     std::unordered_map<GeoId, UniqueBoundsBox>  mShapes;     // 绘制的形状
-    std::unordered_map<LandID, UniqueBoundsBox> mLandShapes; // 绘制的领地
+    std::unordered_map<LandID, SharedBoundsBox> mLandShapes; // 绘制的领地(共享几何体)
+    std::unordered_map<LandID, mce::Color>      mLandColors; // 领地绘制颜色
+    LandGeometryCache&                          mGeometryCache;
+    PacketScheduler&                            mScheduler;
+
+    explicit Impl(LandGeometryCache& cache, PacketScheduler& scheduler)
+    : mGeometryCache(cache),
+      mScheduler(scheduler) {}
 };
 
 
 // interface
-DebugShapeHandle::DebugShapeHandle() : impl_(std::make_unique<Impl>()) {}
-DebugShapeHandle::~DebugShapeHandle() = default;
+DebugShapeHandle::DebugShapeHandle(LandGeometryCache& cache, PacketScheduler& scheduler)
+: impl_(std::make_unique<Impl>(cache, scheduler)) {
+    // 领地任务被丢弃时撤销绘制记录，后续 draw 才会重新投递
+    impl_->mScheduler.attach(*this, {}, [impl = impl_.get()](uint64 key) {
+        if (PacketScheduler::keyChannel(key) != LandKeyChannel) {
+            return;
+        }
+        auto landId = static_cast<LandID>(PacketScheduler::keyId(key));
+        impl->mLandShapes.erase(landId);
+        impl->mLandColors.erase(landId);
+    });
+}
+DebugShapeHandle::~DebugShapeHandle() {
+    clearLand(); // 需在注销前执行，以便取消仍在队列中的任务
+    impl_->mScheduler.detach(*this);
+}
 
 GeoId DebugShapeHandle::draw(LandAABB const& aabb, DimensionType dimId, mce::Color const& color) {
     auto box = newBoundsBox(toMinecraftAABB(aabb), color);
     box->setColor(color);
     box->setDimensionId(dimId);
-    getTargetPlayer().and_then([&](Player& player) { box->draw(player); });
 
     auto id = allocatedID();
+    // 形状由 mShapes 持有，移除时会先取消未发送的任务
+    impl_->mScheduler.enqueue(*this, shapeKey(id), [raw = box.get()](Player& player) { raw->draw(player); });
     impl_->mShapes.emplace(id, std::move(box));
     return id;
 }
@@ -137,16 +176,25 @@ void DebugShapeHandle::draw(std::shared_ptr<Land> const& land, mce::Color const&
     if (impl_->mLandShapes.contains(land->getId())) {
         return; // 已经绘制过
     }
-    auto box = newBoundsBox(toMinecraftAABB(land->getAABB()), color);
-    box->setColor(color);
-    box->setDimensionId(land->getDimensionId());
-    getTargetPlayer().and_then([&](Player& player) { box->draw(player); });
+    auto box = impl_->mGeometryCache.acquire<debug_shape::extension::IBoundsBox>(
+        land->getId(),
+        packColor(color),
+        [&]() -> SharedBoundsBox {
+            auto box = newBoundsBox(toMinecraftAABB(land->getAABB()), color);
+            box->setColor(color);
+            box->setDimensionId(land->getDimensionId());
+            return box;
+        }
+    );
+    impl_->mScheduler.enqueue(*this, landKey(land->getId()), [box](Player& player) { box->draw(player); });
     impl_->mLandShapes.emplace(land->getId(), std::move(box));
+    impl_->mLandColors.insert_or_assign(land->getId(), color);
 }
 
 void DebugShapeHandle::remove(GeoId id) {
     auto iter = impl_->mShapes.find(id);
     if (iter != impl_->mShapes.end()) {
+        impl_->mScheduler.cancel(*this, shapeKey(id));
         impl_->mShapes.erase(iter);
     }
 }
@@ -154,18 +202,44 @@ void DebugShapeHandle::remove(GeoId id) {
 void DebugShapeHandle::remove(LandID landId) {
     auto iter = impl_->mLandShapes.find(landId);
     if (iter != impl_->mLandShapes.end()) {
+        // 几何体可能仍被其他玩家订阅，仅从当前玩家移除；尚未发送则直接取消
+        if (!impl_->mScheduler.cancel(*this, landKey(landId))) {
+            getTargetPlayer().and_then([&](Player& player) { iter->second->remove(player); });
+        }
         impl_->mLandShapes.erase(iter);
+        impl_->mLandColors.erase(landId);
     }
 }
 
 void DebugShapeHandle::remove(std::shared_ptr<Land> land) { remove(land->getId()); }
 
 void DebugShapeHandle::clear() {
+    impl_->mScheduler.cancelAll(*this);
     impl_->mShapes.clear();
+    clearLand();
+}
+
+void DebugShapeHandle::clearLand() {
+    getTargetPlayer().and_then([&](Player& player) {
+        for (auto& [landId, box] : impl_->mLandShapes) {
+            if (!impl_->mScheduler.cancel(*this, landKey(landId))) {
+                box->remove(player);
+            }
+        }
+    });
     impl_->mLandShapes.clear();
+    impl_->mLandColors.clear();
 }
 
-void DebugShapeHandle::clearLand() { impl_->mLandShapes.clear(); }
+void DebugShapeHandle::refresh(std::shared_ptr<Land> const& land) {
+    auto iter = impl_->mLandColors.find(land->getId());
+    if (iter == impl_->mLandColors.end()) {
+        return;
+    }
+    auto color = iter->second;
+    remove(land->getId());
+    draw(land, color);
+}
 bool DebugShapeHandle::isDebugShapeLoaded() { return detail::isDebugShapeLoaded(); }
 
 
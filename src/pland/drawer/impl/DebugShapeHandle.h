@@ -2,6 +2,11 @@
 #include "IDrawerHandle.h"
 #include "pland/Global.h"
 
+namespace land::drawer {
+class LandGeometryCache;
+class PacketScheduler;
+} // namespace land::drawer
+
 namespace land::drawer::detail {
 
 class DebugShapeHandle final : public IDrawerHandle {
@@ -9,7 +14,7 @@ class DebugShapeHandle final : public IDrawerHandle {
     std::unique_ptr<Impl> impl_;
 
 public:
-    DebugShapeHandle();
+    explicit DebugShapeHandle(LandGeometryCache& cache, PacketScheduler& scheduler);
     ~DebugShapeHandle() override;
 
     GeoId draw(LandAABB const& aabb, DimensionType dimId, mce::Color const& color) override;
@@ -26,6 +31,8 @@ class DebugShapeHandle final : public IDrawerHandle {
 
     void clearLand() override;
 
+    void refresh(std::shared_ptr<Land> const& land) override;
+
     static bool isDebugShapeLoaded();
 };
 
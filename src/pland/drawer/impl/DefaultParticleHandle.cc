@@ -3,19 +3,19 @@
 #include "pland/Global.h"
 #include "pland/PLand.h"
 #include "pland/aabb/LandAABB.h"
+#include "pland/drawer/LandGeometryCache.h"
+#include "pland/drawer/PacketScheduler.h"
+#include "pland/infra/Config.h"
 #include "pland/land/Land.h"
 
-#include "ll/api/chrono/GameChrono.h"
-#include "ll/api/coro/CoroTask.h"
-#include "ll/api/coro/InterruptableSleep.h"
-#include "ll/api/thread/ServerThreadExecutor.h"
-
 #include "mc/network/packet/SpawnParticleEffectPacket.h"
 #include "mc/util/MolangVariable.h"
 #include "mc/util/MolangVariableMap.h"
 #include "mc/world/level/dimension/VanillaDimensions.h"
 
-#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <optional>
 
 
 // Fix LNK2019: "public: __cdecl MolangVariableMap::MolangVariableMap(class MolangVariableMap const &)"
@@ -32,94 +32,264 @@ MolangScriptArg::MolangScriptArg() = default;
 namespace land::drawer::detail {
 
 
+/**
+ * @brief 粒子轮廓几何体，同一领地的轮廓由所有玩家共享
+ */
+struct ParticleOutline {
+    DimensionType        dimension;
+    LandAABB::CornerList corners; // 角点单独发送，边线只发送内部点，避免重复
+    LandAABB::EdgeList   edges;
+
+    static std::shared_ptr<ParticleOutline> make(LandAABB const& aabb, LandDimid dimId) {
+        auto maybeDimid = VanillaDimensions::fromSerializedInt(dimId);
+        if (!maybeDimid.has_value()) {
+            PLand::getInstance().getSelf().getLogger().error("[ParticleSpawner] Unknown dimension id: {}", dimId);
+            return nullptr;
+        }
+        return std::make_shared<ParticleOutline>(ParticleOutline{maybeDimid.value(), aabb.corners(), aabb.edges()});
+    }
+};
+
 class ParticleSpawner {
     GeoId                                  mId;
-    std::vector<SpawnParticleEffectPacket> mPackets;
+    std::shared_ptr<ParticleOutline const> mOutline; // 共享几何体，为空表示无效
+
+    // 本轮绘制游标
+    size_t mCornerCursor{0};
+    size_t mEdgeCursor{0};
+    bool   mEdgeActive{false};
+    int    mAxis{0};
+    int    mCursor{0};
+    int    mEnd{0};
+    int    mStride{1};
 
     static GeoId getNextGeoId() {
         static uint64 id{1};
         return GeoId{id++};
     }
 
-public:
-    LD_DISABLE_COPY(ParticleSpawner);
-    ParticleSpawner(ParticleSpawner&&) noexcept            = default;
-    ParticleSpawner& operator=(ParticleSpawner&&) noexcept = default;
+    static int getAxis(BlockPos const& a, BlockPos const& b) {
+        if (a.x != b.x) return 0;
+        if (a.y != b.y) return 1;
+        return 2;
+    }
 
-    explicit ParticleSpawner(LandAABB const& aabb, LandDimid dimId) : mId(getNextGeoId()) {
+    static void send(Player& player, BlockPos const& point, DimensionType dimension) {
         static std::optional<MolangVariableMap> molang{std::nullopt};
+        static std::string const                particle = "minecraft:villager_happy";
 
-        auto maybeDimid = VanillaDimensions::fromSerializedInt(dimId);
-        if (!maybeDimid.has_value()) {
-            PLand::getInstance().getSelf().getLogger().error("[ParticleSpawner] Unknown dimension id: {}", dimId);
-            return;
+        SpawnParticleEffectPacket{Vec3{point.x + 0.5, point.y + 0.5, point.z + 0.5}, particle, dimension, molang}
+            .sendTo(player);
+    }
+
+    static int&  at(BlockPos& pos, int axis) { return axis == 0 ? pos.x : axis == 1 ? pos.y : pos.z; }
+    static float at(Vec3 const& pos, int axis) { return axis == 0 ? pos.x : axis == 1 ? pos.y : pos.z; }
+
+    /**
+     * @brief 计算边线内部点在可视距离内的区间以及采样步长
+     * @return 边线完全不可见时返回 false
+     */
+    bool beginEdge(Vec3 const& viewer) {
+        auto const& cfg = Config::cfg.land.particleDrawer;
+
+        auto [from, to] = mOutline->edges.data[mEdgeCursor];
+        mAxis           = getAxis(from, to);
+
+        int lo          = at(from, mAxis) + 1; // 两端为角点，已单独发送
+        int hi          = at(to, mAxis) - 1;
+        at(from, mAxis) = 0;
+        if (lo > hi) {
+            return false;
+        }
+
+        // 视点到边线所在直线的垂直距离
+        auto  center     = Vec3{from.x + 0.5f, from.y + 0.5f, from.z + 0.5f};
+        float perpSquare = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (axis == mAxis) continue;
+            float d     = at(center, axis) - at(viewer, axis);
+            perpSquare += d * d;
         }
-        auto dim = maybeDimid.value();
 
-        static std::string const particle = "minecraft:villager_happy";
+        float radius = static_cast<float>(cfg.viewDistance);
+        if (perpSquare > radius * radius) {
+            return false;
+        }
+        // 可视球与边线相交的弦
+        float halfChord = std::sqrt(radius * radius - perpSquare);
+        float viewAxis  = at(viewer, mAxis) - 0.5f;
+        int   visibleLo = std::max(lo, static_cast<int>(std::ceil(viewAxis - halfChord)));
+        int   visibleHi = std::min(hi, static_cast<int>(std::floor(viewAxis + halfChord)));
+        if (visibleLo > visibleHi) {
+            return false;
+        }
 
-        auto points = aabb.getBorder();
-        mPackets.reserve(points.size());
-        for (auto& point : points) {
-            mPackets.emplace_back(Vec3{point.x + 0.5, point.y + 0.5, point.z + 0.5}, particle, dim, molang);
+        // 按最近点距离决定 LOD 步长
+        float nearest  = std::clamp(viewAxis, static_cast<float>(visibleLo), static_cast<float>(visibleHi));
+        float distance = std::sqrt(perpSquare + (nearest - viewAxis) * (nearest - viewAxis));
+        mStride        = 1;
+        if (cfg.lodDistance > 0 && distance > cfg.lodDistance) {
+            mStride = std::clamp(static_cast<int>(distance) / cfg.lodDistance + 1, 1, std::max(cfg.maxStride, 1));
         }
+
+        // 采样点对齐到步长倍数，避免玩家移动时粒子位置抖动
+        int origin = lo - 1;
+        mCursor    = origin + std::max((visibleLo - origin + mStride - 1) / mStride, 1) * mStride;
+        mEnd       = visibleHi;
+        return true;
     }
 
+public:
+    LD_DISABLE_COPY(ParticleSpawner);
+    ParticleSpawner(ParticleSpawner&&) noexcept            = default;
+    ParticleSpawner& operator=(ParticleSpawner&&) noexcept = default;
+
+    explicit ParticleSpawner(std::shared_ptr<ParticleOutline const> outline)
+    : mId(getNextGeoId()),
+      mOutline(std::move(outline)) {}
+
     GeoId getId() const { return mId; }
 
-    void tick(Player& player) {
-        for (auto& packet : mPackets) {
-            packet.sendTo(player);
+    bool isDone() const {
+        return !mOutline || (mCornerCursor >= mOutline->corners.size && mEdgeCursor >= mOutline->edges.size);
+    }
+
+    void reset() {
+        mCornerCursor = 0;
+        mEdgeCursor   = 0;
+        mEdgeActive   = false;
+    }
+
+    /**
+     * @brief 按预算发送本轮剩余的粒子
+     * @return 实际发送的粒子包数量
+     */
+    int tick(Player& player, int budget) {
+        if (!mOutline) {
+            return 0;
+        }
+        auto const& outline = *mOutline;
+        if (player.getDimensionId() != outline.dimension) {
+            mCornerCursor = outline.corners.size;
+            mEdgeCursor   = outline.edges.size;
+            return 0;
+        }
+
+        auto const& viewer = player.getPosition();
+        float const radius = static_cast<float>(Config::cfg.land.particleDrawer.viewDistance);
+
+        int sent = 0;
+        for (; mCornerCursor < outline.corners.size && sent < budget; ++mCornerCursor) {
+            auto const& corner = outline.corners.data[mCornerCursor];
+            float       dx     = corner.x + 0.5f - viewer.x;
+            float       dy     = corner.y + 0.5f - viewer.y;
+            float       dz     = corner.z + 0.5f - viewer.z;
+            if (dx * dx + dy * dy + dz * dz <= radius * radius) {
+                send(player, corner, outline.dimension);
+                ++sent;
+            }
+        }
+
+        while (mEdgeCursor < outline.edges.size && sent < budget) {
+            if (!mEdgeActive) {
+                if (!beginEdge(viewer)) {
+                    ++mEdgeCursor;
+                    continue;
+                }
+                mEdgeActive = true;
+            }
+
+            auto point = outline.edges.data[mEdgeCursor].first;
+            for (; mCursor <= mEnd && sent < budget; mCursor += mStride, ++sent) {
+                at(point, mAxis) = mCursor;
+                send(player, point, outline.dimension);
+            }
+            if (mCursor > mEnd) {
+                mEdgeActive = false;
+                ++mEdgeCursor;
+            }
         }
+        return sent;
     }
 };
 
 class DefaultParticleHandle::Impl {
+    static constexpr uint64 RefreshIntervalTicks = 30; // 粒子刷新间隔
+
     std::unordered_map<GeoId, ParticleSpawner>    mSpawners;
     std::unordered_map<LandID, GeoId>             mDrawedLands;
-    std::shared_ptr<std::atomic<bool>>            mQuit;
-    std::shared_ptr<ll::coro::InterruptableSleep> mSleep;
+    std::vector<GeoId>                            mPending; // 本轮待绘制
+    size_t                                        mPendingCursor{0};
+    std::optional<uint64>                         mLastRefreshTick; // 上一轮开始的调度器 tick
     DefaultParticleHandle&                        mOwner;
+    LandGeometryCache&                            mGeometryCache;
+    PacketScheduler&                              mScheduler;
 
 public:
-    explicit Impl(DefaultParticleHandle& owner) : mOwner(owner) {
-        mQuit  = std::make_shared<std::atomic<bool>>(false);
-        mSleep = std::make_shared<ll::coro::InterruptableSleep>();
-
-        ll::coro::keepThis([quit = mQuit, sleep = mSleep, this]() -> ll::coro::CoroTask<> {
-            while (!quit->load()) {
-                co_await sleep->sleepFor(ll::chrono::ticks{30});
-                if (quit->load()) {
-                    break;
-                }
-                mOwner.getTargetPlayer().and_then([this](Player& player) {
-                    for (auto& [id, spawner] : mSpawners) {
-                        spawner.tick(player);
-                    }
-                });
-            }
-            co_return;
-        }).launch(ll::thread::ServerThreadExecutor::getDefault());
+    explicit Impl(DefaultParticleHandle& owner, LandGeometryCache& cache, PacketScheduler& scheduler)
+    : mOwner(owner),
+      mGeometryCache(cache),
+      mScheduler(scheduler) {
+        // 粒子按预算流式生成，由调度器每 tick 拉取
+        mScheduler.attach(mOwner, [this](Player& player, int budget) { return tick(player, budget); });
     }
 
-    ~Impl() {
-        mQuit->store(true);
-        mSleep->interrupt(true);
+    int tick(Player& player, int budget) {
+        // 生产者只在调度器有剩余预算时被调用，按调度器 tick 而不是调用次数计算间隔
+        auto now = mScheduler.getCurrentTick();
+        if (!mLastRefreshTick || now - *mLastRefreshTick >= RefreshIntervalTicks) {
+            mLastRefreshTick = now;
+            // 开始新一轮绘制，上一轮未发送完的粒子直接丢弃
+            mPending.clear();
+            mPending.reserve(mSpawners.size());
+            for (auto& [id, spawner] : mSpawners) {
+                spawner.reset();
+                mPending.push_back(id);
+            }
+            mPendingCursor = 0;
+        }
+
+        int sent = 0;
+        while (mPendingCursor < mPending.size() && sent < budget) {
+            auto iter = mSpawners.find(mPending[mPendingCursor]);
+            if (iter == mSpawners.end()) {
+                ++mPendingCursor; // 已被移除
+                continue;
+            }
+            sent += iter->second.tick(player, budget - sent);
+            if (iter->second.isDone()) {
+                ++mPendingCursor;
+            }
+        }
+        return sent;
     }
 
-    GeoId draw(LandAABB const& aabb, LandDimid dimId) {
-        auto spawner = ParticleSpawner(aabb, dimId);
+    ~Impl() { mScheduler.detach(mOwner); }
+
+    GeoId draw(std::shared_ptr<ParticleOutline const> outline) {
+        auto spawner = ParticleSpawner(std::move(outline));
         auto id      = spawner.getId();
         mSpawners.insert({id, std::move(spawner)});
         return id;
     }
 
+    GeoId draw(LandAABB const& aabb, LandDimid dimId) { return this->draw(ParticleOutline::make(aabb, dimId)); }
+
     void draw(SharedLand const& land) {
         if (mDrawedLands.contains(land->getId())) {
             return;
         }
-        auto id                     = this->draw(land->getAABB(), land->getDimensionId());
-        mDrawedLands[land->getId()] = id;
+        auto outline = mGeometryCache.acquire<ParticleOutline>(land->getId(), 0, [&land] {
+            return ParticleOutline::make(land->getAABB(), land->getDimensionId());
+        });
+        mDrawedLands[land->getId()] = this->draw(std::move(outline));
+    }
+
+    void refresh(SharedLand const& land) {
+        if (mDrawedLands.contains(land->getId())) {
+            this->remove(land->getId());
+            this->draw(land);
+        }
     }
 
     void remove(GeoId id) {
@@ -155,7 +325,8 @@ class DefaultParticleHandle::Impl {
     }
 };
 
-DefaultParticleHandle::DefaultParticleHandle() : impl(std::make_unique<Impl>(*this)) {}
+DefaultParticleHandle::DefaultParticleHandle(LandGeometryCache& cache, PacketScheduler& scheduler)
+: impl(std::make_unique<Impl>(*this, cache, scheduler)) {}
 
 DefaultParticleHandle::~DefaultParticleHandle() = default;
 
@@ -175,5 +346,7 @@ void DefaultParticleHandle::clear() { impl->clear(); }
 
 void DefaultParticleHandle::clearLand() { impl->clearLand(); }
 
+void DefaultParticleHandle::refresh(std::shared_ptr<Land> const& land) { impl->refresh(land); }
+
 
 } // namespace land::drawer::detail
\ No newline at end of file
@@ -4,6 +4,11 @@
 #include <memory>
 
 
+namespace land::drawer {
+class LandGeometryCache;
+class PacketScheduler;
+} // namespace land::drawer
+
 namespace land::drawer::detail {
 
 
@@ -12,7 +17,7 @@ class DefaultParticleHandle final : public IDrawerHandle {
     std::unique_ptr<Impl> impl;
 
 public:
-    explicit DefaultParticleHandle();
+    explicit DefaultParticleHandle(LandGeometryCache& cache, PacketScheduler& scheduler);
     ~DefaultParticleHandle() override;
 
     GeoId draw(LandAABB const& aabb, DimensionType dimId, mce::Color const& color) override;
@@ -28,6 +33,8 @@ class DefaultParticleHandle final : public IDrawerHandle {
     void clear() override;
 
     void clearLand() override;
+
+    void refresh(std::shared_ptr<Land> const& land) override;
 };
 
 
@@ -53,6 +53,11 @@ class IDrawerHandle {
     virtual void clear() = 0;
 
     virtual void clearLand() = 0;
+
+    /**
+     * @brief 领地范围变更后，若已绘制该领地则按新范围重新绘制
+     */
+    virtual void refresh(std::shared_ptr<Land> const& land) = 0;
 };
 
 
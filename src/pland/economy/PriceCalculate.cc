@@ -1,5 +1,17 @@
 #include "pland/economy/PriceCalculate.h"
+#include "pland/PLand.h"
 #include "pland/aabb/LandAABB.h"
+#include "pland/infra/Config.h"
+
+#include "ll/api/thread/ThreadPoolExecutor.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
 
 
 #pragma warning(disable : 4702)
@@ -37,7 +49,104 @@ PriceCalculate::Variable PriceCalculate::Variable::make(int height, int width, i
 }
 
 
-double PriceCalculate::eval(std::string const& code, Variable const& variables) {
+namespace {
+
+// 公式变量块，预编译的公式直接绑定其成员
+struct VariableBlock {
+    double height{0};
+    double width{0};
+    double depth{0};
+    double square{0};
+    double volume{0};
+    double dimensionId{0};
+};
+
+constexpr std::array<std::pair<std::string_view, double VariableBlock::*>, 6> VariableBindings{
+    {{"height", &VariableBlock::height},
+     {"width", &VariableBlock::width},
+     {"depth", &VariableBlock::depth},
+     {"square", &VariableBlock::square},
+     {"volume", &VariableBlock::volume},
+     {"dimensionId", &VariableBlock::dimensionId}}
+};
+
+/**
+ * @brief 预编译公式，求值时只需写入变量块
+ */
+struct CompiledFormula {
+    VariableBlock                block;
+    exprtk::symbol_table<double> symbols;
+    exprtk::expression<double>   expr;
+    std::string                  error; // 编译错误，为空表示编译成功
+    std::mutex                   mutex; // 变量块在求值期间独占
+
+    explicit CompiledFormula(std::string const& code) {
+        for (auto const& [name, member] : VariableBindings) {
+            symbols.add_variable(std::string{name}, block.*member);
+        }
+        symbols.add_function("random_num", &internals::random_num);
+        symbols.add_function("random_num_range", &internals::random_num_range);
+        expr.register_symbol_table(symbols);
+
+        exprtk::parser<double> parser;
+        if (!parser.compile(code, expr)) {
+            error = parser.error();
+        }
+    }
+
+    bool ok() const { return error.empty(); }
+
+    static bool isBindable(PriceCalculate::Variable const& variables) {
+        return std::ranges::all_of(variables.get(), [](auto const& entry) {
+            return std::ranges::any_of(VariableBindings, [&](auto const& binding) {
+                return binding.first == entry.first;
+            });
+        });
+    }
+
+    void bind(PriceCalculate::BatchInput const& input, size_t index) {
+        block.height      = input.height[index];
+        block.width       = input.width[index];
+        block.depth       = input.depth[index];
+        block.square      = input.square[index];
+        block.volume      = input.volume[index];
+        block.dimensionId = input.dimensionId[index];
+    }
+
+    // 调用方需保证独占变量块
+    void evalRange(PriceCalculate::BatchInput const& input, std::vector<double>& prices, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            bind(input, i);
+            prices[i] = expr.value();
+        }
+    }
+
+    double eval(PriceCalculate::Variable const& variables) {
+        std::lock_guard lock(mutex);
+        block = {};
+        for (auto const& [name, member] : VariableBindings) {
+            if (auto iter = variables.get().find(std::string{name}); iter != variables.get().end()) {
+                block.*member = iter->second;
+            }
+        }
+        return expr.value();
+    }
+};
+
+std::unordered_map<std::string, std::shared_ptr<CompiledFormula>> FormulaCache;
+std::mutex                                                        FormulaCacheMutex;
+
+std::shared_ptr<CompiledFormula> acquireFormula(std::string const& code) {
+    std::lock_guard lock(FormulaCacheMutex);
+    auto&           formula = FormulaCache[code];
+    if (!formula) {
+        formula = std::make_shared<CompiledFormula>(code); // 编译失败的结果同样缓存，避免重复编译
+    }
+    return formula;
+}
+
+// 含有自定义变量时无法绑定到变量块，按旧方式即时编译
+double evalUncached(std::string const& code, PriceCalculate::Variable const& variables) {
     exprtk::symbol_table<double> symbols;
 
     for (auto const& [key, value] : variables.get()) {
@@ -61,6 +170,197 @@ double PriceCalculate::eval(std::string const& code, Variable const& variables)
     return expr.value(); // 计算结果
 }
 
+/**
+ * @brief 并行批量计算任务，分块由调用线程与线程池共同领取
+ * @note 线程池任务可能在调用返回后才开始执行，此时已无分块可领取，不会再访问输入与输出
+ */
+struct BatchJob {
+    std::string                       code;
+    PriceCalculate::BatchInput const* input{nullptr};
+    std::vector<double>*              prices{nullptr};
+    size_t                            chunkCount{0};
+    std::atomic<size_t>               next{0};
+    std::atomic<size_t>               finished{0};
+
+    void work() {
+        std::unique_ptr<CompiledFormula> formula; // 每个线程独立编译，变量块互不干扰
+        for (auto chunk = next.fetch_add(1); chunk < chunkCount; chunk = next.fetch_add(1)) {
+            if (!formula) {
+                formula = std::make_unique<CompiledFormula>(code);
+            }
+            auto begin = chunk * PriceCalculate::BatchChunkSize;
+            auto end   = std::min(begin + PriceCalculate::BatchChunkSize, input->size());
+            formula->evalRange(*input, *prices, begin, end);
+            if (finished.fetch_add(1) + 1 == chunkCount) {
+                finished.notify_all();
+            }
+        }
+    }
+};
+
+void evalParallel(std::string const& code, PriceCalculate::BatchInput const& input, std::vector<double>& prices) {
+    auto job        = std::make_shared<BatchJob>();
+    job->code       = code;
+    job->input      = &input;
+    job->prices     = &prices;
+    job->chunkCount = (input.size() + PriceCalculate::BatchChunkSize - 1) / PriceCalculate::BatchChunkSize;
+
+    if (auto pool = PLand::getInstance().getThreadPool()) {
+        auto helpers = std::min<size_t>(job->chunkCount - 1, std::max(std::thread::hardware_concurrency(), 2u) - 1);
+        for (size_t i = 0; i < helpers; ++i) {
+            pool->execute([job] { job->work(); });
+        }
+    }
+    job->work(); // 调用线程同样参与计算，线程池繁忙时也不会阻塞
+
+    for (auto done = job->finished.load(); done < job->chunkCount; done = job->finished.load()) {
+        job->finished.wait(done);
+    }
+}
+
+} // namespace
+
+
+size_t PriceCalculate::BatchInput::size() const { return height.size(); }
+
+void PriceCalculate::BatchInput::reserve(size_t count) {
+    height.reserve(count);
+    width.reserve(count);
+    depth.reserve(count);
+    square.reserve(count);
+    volume.reserve(count);
+    dimensionId.reserve(count);
+    parent.reserve(count);
+}
+
+void PriceCalculate::BatchInput::push(LandAABB const& aabb, int dimId, int parentIndex) {
+    height.push_back(aabb.getBlockCountY());
+    width.push_back(aabb.getBlockCountZ());
+    depth.push_back(aabb.getBlockCountX());
+    square.push_back(static_cast<double>(aabb.getSquare()));
+    volume.push_back(static_cast<double>(aabb.getVolume()));
+    dimensionId.push_back(static_cast<double>(dimId));
+    parent.push_back(parentIndex);
+}
+
+PriceCalculate::BatchInput PriceCalculate::BatchInput::make(std::vector<SharedLand> const& lands) {
+    std::unordered_map<LandID, int> indices;
+    indices.reserve(lands.size());
+    for (size_t i = 0; i < lands.size(); ++i) {
+        indices.emplace(lands[i]->getId(), static_cast<int>(i));
+    }
+
+    BatchInput input;
+    input.reserve(lands.size());
+    for (auto const& land : lands) {
+        int parentIndex = -1;
+        if (land->hasParentLand()) {
+            if (auto parent = land->getParentLand()) {
+                if (auto iter = indices.find(parent->getId()); iter != indices.end()) {
+                    parentIndex = iter->second;
+                }
+            }
+        }
+        input.push(land->getAABB(), land->getDimensionId(), parentIndex);
+    }
+    return input;
+}
+
+
+double PriceCalculate::eval(std::string const& code, Variable const& variables) {
+    if (!CompiledFormula::isBindable(variables)) {
+        return evalUncached(code, variables);
+    }
+    auto formula = acquireFormula(code);
+    if (!formula->ok()) {
+        return 0; // 编译错误已在加载配置时输出
+    }
+    return formula->eval(variables);
+}
+
+ll::Expected<PriceCalculate::BatchResult> PriceCalculate::evalBatch(std::string const& code, BatchInput const& input) {
+    auto const count = input.size();
+    if (input.width.size() != count || input.depth.size() != count || input.square.size() != count
+        || input.volume.size() != count || input.dimensionId.size() != count || input.parent.size() != count) {
+        return ll::makeStringError("Batch input arrays have mismatched sizes");
+    }
+    for (auto parent : input.parent) {
+        if (parent >= static_cast<int>(count)) {
+            return ll::makeStringError("Batch input parent index out of range");
+        }
+    }
+
+    auto formula = acquireFormula(code);
+    if (!formula->ok()) {
+        return ll::makeStringError(formula->error);
+    }
+
+    BatchResult result;
+    result.prices.resize(count);
+    if (count >= BatchParallelThreshold) {
+        evalParallel(code, input, result.prices);
+    } else {
+        std::lock_guard lock(formula->mutex);
+        formula->evalRange(input, result.prices, 0, count);
+    }
+    result.totals = sumSubtrees(result.prices, input.parent);
+    return result;
+}
+
+std::vector<double> PriceCalculate::sumSubtrees(std::vector<double> const& prices, std::vector<int> const& parent) {
+    auto const          count = prices.size();
+    std::vector<double> totals(prices);
+    std::vector<int>    pending(count, 0); // 尚未汇总的子节点数量
+    for (size_t i = 0; i < count; ++i) {
+        if (parent[i] >= 0) {
+            ++pending[parent[i]];
+        }
+    }
+
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < count; ++i) {
+        if (pending[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+    while (!ready.empty()) {
+        auto index = ready.back();
+        ready.pop_back();
+        if (auto up = parent[index]; up >= 0) {
+            totals[up] += totals[index];
+            if (--pending[up] == 0) {
+                ready.push_back(static_cast<size_t>(up));
+            }
+        }
+    }
+    return totals;
+}
+
+ll::Expected<> PriceCalculate::compile(std::string const& code) {
+    auto formula = acquireFormula(code);
+    if (!formula->ok()) {
+        return ll::makeStringError(formula->error);
+    }
+    return {};
+}
+
+void PriceCalculate::reloadCache() {
+    {
+        std::lock_guard lock(FormulaCacheMutex);
+        FormulaCache.clear();
+    }
+
+    auto& logger = PLand::getInstance().getSelf().getLogger();
+    for (auto const* code :
+         {&Config::cfg.land.bought.twoDimensionl.calculate,
+          &Config::cfg.land.bought.threeDimensionl.calculate,
+          &Config::cfg.land.subLand.calculate}) {
+        if (auto res = compile(*code); !res) {
+            logger.error("Failed to compile price formula \"{}\": {}", *code, res.error().message());
+        }
+    }
+}
+
 
 int PriceCalculate::calculateDiscountPrice(double originalPrice, double discountRate) {
     // discountRate为1时表示原价，为0.9时表示打9折
@@ -75,18 +375,22 @@ int PriceCalculate::calculateRefundsPrice(double originalPrice, double refundRat
 
 namespace internals {
 
+namespace {
+// 公式可能在多个线程中同时求值，随机数引擎按线程独立
+std::mt19937& randomEngine() {
+    thread_local std::mt19937 gen(std::random_device{}());
+    return gen;
+}
+} // namespace
+
 double random_num() {
-    static std::random_device               rd;
-    static std::mt19937                     gen(rd());
-    static std::uniform_real_distribution<> dis(0.0, 1.0);
-    return dis(gen);
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+    return dis(randomEngine());
 }
 
 double random_num_range(double min, double max) {
-    static std::random_device        rd;
-    static std::mt19937              gen(rd());
     std::uniform_real_distribution<> dis(min, max);
-    return dis(gen);
+    return dis(randomEngine());
 }
 
 } // namespace internals
@@ -1,7 +1,14 @@
 #pragma once
 #include "pland/Global.h"
 #include "pland/aabb/LandAABB.h"
+#include "pland/land/Land.h"
+
+#include "ll/api/Expected.h"
+
+#include <cstddef>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace land {
 
@@ -35,12 +42,67 @@ class PriceCalculate {
         LDNDAPI static Variable make(int height, int width, int depth, int dimensionId);
     };
 
+    /**
+     * @brief 批量计算输入(结构数组布局)
+     */
+    struct BatchInput {
+        std::vector<double> height;
+        std::vector<double> width;
+        std::vector<double> depth;
+        std::vector<double> square;
+        std::vector<double> volume;
+        std::vector<double> dimensionId;
+        std::vector<int>    parent; // 父领地在批次中的下标，-1 表示无
+
+        LDNDAPI size_t size() const;
+
+        LDAPI void reserve(size_t count);
+
+        LDAPI void push(LandAABB const& aabb, int dimensionId, int parentIndex = -1);
+
+        /**
+         * @brief 由领地列表构建，批次内的父子关系用于汇总子树总价
+         */
+        LDNDAPI static BatchInput make(std::vector<SharedLand> const& lands);
+    };
+
+    struct BatchResult {
+        std::vector<double> prices; // 各领地价格
+        std::vector<double> totals; // 各领地及其批次内子孙领地的总价
+    };
+
+    static constexpr size_t BatchChunkSize         = 1024; // 并行计算的分块大小
+    static constexpr size_t BatchParallelThreshold = 8192; // 超过此数量时使用线程池并行计算
+
 public:
     /**
      * @brief 计算价格
+     * @note 公式按文本缓存编译结果，编译失败时返回 0
      */
     LDNDAPI static double eval(std::string const& code, Variable const& variables);
 
+    /**
+     * @brief 批量计算价格，公式只编译一次
+     * @return 公式编译失败或输入不一致时返回错误
+     */
+    LDNDAPI static ll::Expected<BatchResult> evalBatch(std::string const& code, BatchInput const& input);
+
+    /**
+     * @brief 按父领地下标自底向上汇总子树总价
+     * @param parent 父领地在数组中的下标，-1 表示无
+     */
+    LDNDAPI static std::vector<double> sumSubtrees(std::vector<double> const& prices, std::vector<int> const& parent);
+
+    /**
+     * @brief 编译公式并放入缓存
+     */
+    LDNDAPI static ll::Expected<> compile(std::string const& code);
+
+    /**
+     * @brief 清空公式缓存并预编译配置中的公式，编译错误输出到日志
+     */
+    LDAPI static void reloadCache();
+
     /**
      * @brief 计算折扣价
      */
@@ -18,6 +18,7 @@
 #include "pland/gui/common/EditLandPermTableUtilGUI.h"
 #include "pland/gui/form/BackSimpleForm.h"
 #include "pland/infra/Config.h"
+#include "pland/infra/PlayerNameCache.h"
 #include "pland/land/Land.h"
 #include "pland/land/LandContext.h"
 #include "pland/land/LandCreateValidator.h"
@@ -554,10 +555,11 @@ void LandManagerGUI::sendChangeMemberGUI(Player& player, SharedLand ptr) {
         _sendAddOfflineMemberGUI(self, ptr);
     });
 
-    auto& infos = ll::service::PlayerInfo::getInstance();
-    for (auto& member : ptr->getMembers()) {
-        auto i = infos.fromUuid(member);
-        fm.appendButton(i.has_value() ? i->name : member.asString(), [member, ptr](Player& self) {
+    auto const& members = ptr->getMembers();
+    auto        uuids   = std::vector<mce::UUID>(members.begin(), members.end());
+    auto        names   = PLand::getInstance().getPlayerNameCache()->resolve(uuids);
+    for (size_t i = 0; i < uuids.size(); ++i) {
+        fm.appendButton(std::move(names[i]), [member = uuids[i], ptr](Player& self) {
             _sendRemoveMemberGUI(self, ptr, member);
         });
     }
@@ -694,11 +696,9 @@ void LandManagerGUI::_sendRemoveMemberGUI(Player& player, SharedLand ptr, mce::U
         return;
     }
 
-    auto info = ll::service::PlayerInfo::getInstance().fromUuid(member);
-
     ModalForm fm(
         PLUGIN_NAME + " | 移除成员"_trf(player),
-        "您确定要移除成员 \"{}\" 吗?"_trf(player, info.has_value() ? info->name : member.asString()),
+        "您确定要移除成员 \"{}\" 吗?"_trf(player, PLand::getInstance().getPlayerNameCache()->resolve(member)),
         "确认"_trf(player),
         "返回"_trf(player)
     );
@@ -1,13 +1,14 @@
 #include "LandOperatorManagerGUI.h"
 #include "CommonUtilGUI.h"
 #include "LandManagerGUI.h"
-#include "ll/api/service/PlayerInfo.h"
 #include "pland/PLand.h"
 #include "pland/gui/common/ChooseLandAdvancedUtilGUI.h"
 #include "pland/gui/common/EditLandPermTableUtilGUI.h"
 #include "pland/gui/form/BackPaginatedSimpleForm.h"
 #include "pland/gui/form/BackSimpleForm.h"
+#include "pland/infra/PlayerNameCache.h"
 #include "pland/land/LandContext.h"
+#include "pland/land/LandQuery.h"
 #include "pland/land/LandRegistry.h"
 #include "pland/land/LandTemplatePermTable.h"
 #include "pland/utils/FeedbackUtils.h"
@@ -41,6 +42,7 @@ void LandOperatorManagerGUI::sendMainMenu(Player& player) {
     });
     fm.appendButton("管理指定领地"_trf(player), "textures/ui/magnifyingGlass", "path", [](Player& self) {
         // sendChooseLandGUI(self, PLand::getInstance().getLandRegistry().getLands());
+        // 仅复制指针，无需筛选；视图与按钮由选择器按页懒生成，因此不经过 LandQuery
         sendChooseLandAdvancedGUI(self, PLand::getInstance().getLandRegistry().getLands());
     });
     fm.appendButton("编辑默认权限"_trf(player), "textures/ui/icon_map", "path", [](Player& self) {
@@ -59,28 +61,40 @@ void LandOperatorManagerGUI::sendMainMenu(Player& player) {
 
 
 void LandOperatorManagerGUI::sendChoosePlayerFromDb(Player& player, ChoosePlayerCallback callback) {
-    auto fm = BackSimpleForm<>::make<LandOperatorManagerGUI::sendMainMenu>();
-    fm.setTitle(PLUGIN_NAME + " | 玩家列表"_trf(player));
-    fm.setContent("请选择您要管理的玩家"_trf(player));
-
-    auto const& infos = ll::service::PlayerInfo::getInstance();
-    auto const  lands = PLand::getInstance().getLandRegistry().getLands();
-
-    std::unordered_set<mce::UUID> filtered; // 防止重复
-    for (auto const& ptr : lands) {
-        auto& owner = ptr->getOwner();
-        if (filtered.contains(owner)) {
-            continue;
-        }
-        filtered.insert(owner);
-        auto info = infos.fromUuid(owner);
+    // 领地主人去重与玩家名解析在线程池中完成，服务器线程只负责构建表单
+    using Owners = std::vector<std::pair<mce::UUID, std::string>>;
+    LandQuery::runFor<Owners>(
+        player,
+        LandQuery::capture(PLand::getInstance().getLandRegistry().getLands()),
+        [](LandQuery::Snapshot lands) {
+            std::vector<mce::UUID>        owners;
+            std::unordered_set<mce::UUID> filtered; // 防止重复
+            for (auto const& entry : lands) {
+                if (filtered.insert(entry.owner).second) {
+                    owners.push_back(entry.owner);
+                }
+            }
 
-        fm.appendButton(info.has_value() ? info->name : owner.asString(), [ptr, callback](Player& self) {
-            callback(self, ptr->getOwner());
-        });
-    }
+            auto   names = PLand::getInstance().getPlayerNameCache()->resolve(owners);
+            Owners result;
+            result.reserve(owners.size());
+            for (size_t i = 0; i < owners.size(); ++i) {
+                result.emplace_back(owners[i], std::move(names[i]));
+            }
+            return result;
+        },
+        [callback = std::move(callback)](Player& player, Owners owners) {
+            auto fm = BackSimpleForm<>::make<LandOperatorManagerGUI::sendMainMenu>();
+            fm.setTitle(PLUGIN_NAME + " | 玩家列表"_trf(player));
+            fm.setContent("请选择您要管理的玩家"_trf(player));
+
+            for (auto& [owner, name] : owners) {
+                fm.appendButton(std::move(name), [owner, callback](Player& self) { callback(self, owner); });
+            }
 
-    fm.sendTo(player);
+            fm.sendTo(player);
+        }
+    );
 }
 
 
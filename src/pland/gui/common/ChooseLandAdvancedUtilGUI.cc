@@ -4,22 +4,32 @@
 #include "pland/gui/form/BackPaginatedSimpleForm.h"
 #include "pland/gui/form/BackSimpleForm.h"
 #include "pland/gui/form/PaginatedSimpleForm.h"
+#include "pland/PLand.h"
+#include "pland/land/LandRegistry.h"
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
 
 
 namespace land {
 
 using ll::form::CustomForm;
+using ll::operator""_trl;
 using ll::form::CustomFormResult;
 
 
 class ChooseLandAdvancedUtilGUI::Impl final {
-    std::vector<SharedLand>                 mLands{};                    // 领地数据
-    ChooseCallback                          mCallback{};                 // 回调
-    BackSimpleForm<>::ButtonCallback        mBackCallback{};             // 返回按钮回调
-    std::optional<std::string>              mFuzzyKeyword{std::nullopt}; // 模糊搜索关键字
-    View                                    mCurrentView{View::All};     // 当前视图
-    std::map<View, BackPaginatedSimpleForm> mViews{};                    // 视图
+    std::vector<SharedLand>                           mLands{};                    // 领地数据
+    std::array<std::vector<size_t>, 4>                mBuckets{};                  // 按领地类型分桶的下标
+    ChooseCallback                                    mCallback{};                 // 回调
+    BackSimpleForm<>::ButtonCallback                  mBackCallback{};             // 返回按钮回调
+    std::optional<std::string>                        mFuzzyKeyword{std::nullopt}; // 模糊搜索关键字
+    std::optional<std::unordered_map<LandID, size_t>> mFuzzyRank{std::nullopt};    // 模糊搜索命中的领地 -> 排名
+    View                                              mCurrentView{View::All};     // 当前视图
+    std::map<View, BackPaginatedSimpleForm>           mViews{};                    // 已生成的视图(首次访问时生成)
 
 public:
     explicit Impl(std::vector<SharedLand> lands, ChooseCallback callback, BackSimpleForm<>::ButtonCallback back = {})
@@ -29,6 +39,9 @@ class ChooseLandAdvancedUtilGUI::Impl final {
 #ifdef DEBUG
         std::cout << "ChooseLandAdvancedUtilGUI::Impl::Impl()" << std::endl;
 #endif
+        for (size_t i = 0; i < mLands.size(); ++i) {
+            mBuckets[static_cast<size_t>(mLands[i]->getType())].push_back(i);
+        }
     }
 
 #ifdef DEBUG
@@ -74,126 +87,125 @@ class ChooseLandAdvancedUtilGUI::Impl final {
         };
     }
 
-    void buildForms(Player& player) {
-        if (mViews.empty()) {
-            mViews.emplace(View::All, BackPaginatedSimpleForm::make(makeBackCallback()));
-            mViews.emplace(View::OnlyOrdinary, BackPaginatedSimpleForm::make(makeBackCallback()));
-            mViews.emplace(View::OnlyParent, BackPaginatedSimpleForm::make(makeBackCallback()));
-            mViews.emplace(View::OnlyMix, BackPaginatedSimpleForm::make(makeBackCallback()));
-            mViews.emplace(View::OnlySub, BackPaginatedSimpleForm::make(makeBackCallback()));
-
-            for (auto& [view, form] : mViews) {
-                form.setTitle("选择领地"_trf(player));
-                form.setContent("请选择一个领地:"_trf(player));
-
-                // 重置过滤器（仅在非主视图或存在模糊搜索关键字时）
-                if (view != View::All || mFuzzyKeyword.has_value()) {
-                    form.appendButton(
-                        "重置过滤器"_trf(player),
-                        "textures/ui/refresh_light",
-                        "path",
-                        [thiz = getThis()](Player& self) {
-                            if (!thiz) return;
-                            if (!thiz->mFuzzyKeyword.has_value()) {
-                                thiz->sendView(self, View::All);
-                                return; // 没有模糊搜索关键字，仅重置视图
-                            }
-                            thiz->mViews.clear();
-                            thiz->mFuzzyKeyword = std::nullopt;
-                            thiz->mCurrentView  = View::All;
-                            thiz->sendTo(self); // 重新发送表单
-                        }
-                    );
+    // 视图包含的领地下标，非全部视图直接取对应类型的桶；模糊搜索时按相关度排序
+    std::vector<size_t> collect(View view) const {
+        auto matched = [this](size_t index) { return !mFuzzyRank || mFuzzyRank->contains(mLands[index]->getId()); };
+
+        std::vector<size_t> result;
+        if (view == View::All) {
+            for (size_t i = 0; i < mLands.size(); ++i) {
+                if (matched(i)) {
+                    result.push_back(i);
                 }
+            }
+        } else {
+            std::ranges::copy_if(mBuckets[static_cast<size_t>(view) - 1], std::back_inserter(result), matched);
+        }
+        if (mFuzzyRank) {
+            std::ranges::sort(result, {}, [this](size_t index) { return mFuzzyRank->at(mLands[index]->getId()); });
+        }
+        return result;
+    }
 
-                form.appendButton(
-                    "模糊搜索"_trf(player),
-                    "textures/ui/magnifyingGlass",
-                    "path",
-                    [thiz = getThis()](Player& self) {
-                        if (thiz) {
-                            thiz->sendFuzzySearch(self);
-                        }
+    BackPaginatedSimpleForm& getView(Player& player, View view) {
+        if (auto iter = mViews.find(view); iter != mViews.end()) {
+            return iter->second;
+        }
+        auto& form = mViews.emplace(view, BackPaginatedSimpleForm::make(makeBackCallback())).first->second;
+
+        form.setTitle("选择领地"_trf(player));
+        form.setContent("请选择一个领地:"_trf(player));
+
+        // 重置过滤器（仅在非主视图或存在模糊搜索关键字时）
+        if (view != View::All || mFuzzyKeyword.has_value()) {
+            form.appendButton(
+                "重置过滤器"_trf(player),
+                "textures/ui/refresh_light",
+                "path",
+                [thiz = getThis()](Player& self) {
+                    if (!thiz) return;
+                    if (!thiz->mFuzzyKeyword.has_value()) {
+                        thiz->sendView(self, View::All);
+                        return; // 没有模糊搜索关键字，仅重置视图
                     }
-                );
-                form.onFormCanceled([thiz = getThis()](Player&) { delete thiz; });
-
-                switch (view) {
-                case View::All:
-                    form.appendButton(
-                        "过滤: >全部领地<"_trf(player),
-                        "textures/ui/store_sort_icon",
-                        "path",
-                        makeNextViewCallback()
-                    );
-                    break;
-                case View::OnlyOrdinary:
-                    form.appendButton(
-                        "过滤: >普通领地<"_trf(player),
-                        "textures/ui/store_sort_icon",
-                        "path",
-                        makeNextViewCallback()
-                    );
-                    break;
-                case View::OnlyParent:
-                    form.appendButton(
-                        "过滤: >父领地<"_trf(player),
-                        "textures/ui/store_sort_icon",
-                        "path",
-                        makeNextViewCallback()
-                    );
-                    break;
-                case View::OnlyMix:
-                    form.appendButton(
-                        "过滤: >混合领地<"_trf(player),
-                        "textures/ui/store_sort_icon",
-                        "path",
-                        makeNextViewCallback()
-                    );
-                    break;
-                case View::OnlySub:
-                    form.appendButton(
-                        "过滤: >子领地<"_trf(player),
-                        "textures/ui/store_sort_icon",
-                        "path",
-                        makeNextViewCallback()
-                    );
-                    break;
+                    thiz->mViews.clear();
+                    thiz->mFuzzyKeyword = std::nullopt;
+                    thiz->mFuzzyRank    = std::nullopt;
+                    thiz->sendTo(self); // 重新发送表单
                 }
-            }
+            );
         }
 
-        for (auto const& land : mLands) {
-            if (mFuzzyKeyword && land->getName().find(*mFuzzyKeyword) == std::string::npos) {
-                continue; // 模糊搜索
+        form.appendButton(
+            "模糊搜索"_trf(player),
+            "textures/ui/magnifyingGlass",
+            "path",
+            [thiz = getThis()](Player& self) {
+                if (thiz) {
+                    thiz->sendFuzzySearch(self);
+                }
             }
+        );
+        form.onFormCanceled([thiz = getThis()](Player&) { delete thiz; });
 
-            auto wLand = std::weak_ptr(land);
-
-            std::string text =
-                "{}\n维度: {} | ID: {}"_trf(player, land->getName(), land->getDimensionId(), land->getId());
-
-            mViews.at(View::All).appendButton(text, "textures/ui/icon_recipe_nature", "path", makeCallback(wLand));
-
-            switch (land->getType()) {
-            case Land::Type::Ordinary:
-                mViews.at(View::OnlyOrdinary)
-                    .appendButton(text, "textures/ui/icon_recipe_nature", "path", makeCallback(wLand));
-                break;
-            case Land::Type::Parent:
-                mViews.at(View::OnlyParent)
-                    .appendButton(text, "textures/ui/icon_recipe_nature", "path", makeCallback(wLand));
-                break;
-            case Land::Type::Mix:
-                mViews.at(View::OnlyMix)
-                    .appendButton(text, "textures/ui/icon_recipe_nature", "path", makeCallback(wLand));
-                break;
-            case Land::Type::Sub:
-                mViews.at(View::OnlySub)
-                    .appendButton(text, "textures/ui/icon_recipe_nature", "path", makeCallback(wLand));
-                break;
-            }
+        switch (view) {
+        case View::All:
+            form.appendButton(
+                "过滤: >全部领地<"_trf(player),
+                "textures/ui/store_sort_icon",
+                "path",
+                makeNextViewCallback()
+            );
+            break;
+        case View::OnlyOrdinary:
+            form.appendButton(
+                "过滤: >普通领地<"_trf(player),
+                "textures/ui/store_sort_icon",
+                "path",
+                makeNextViewCallback()
+            );
+            break;
+        case View::OnlyParent:
+            form.appendButton(
+                "过滤: >父领地<"_trf(player),
+                "textures/ui/store_sort_icon",
+                "path",
+                makeNextViewCallback()
+            );
+            break;
+        case View::OnlyMix:
+            form.appendButton(
+                "过滤: >混合领地<"_trf(player),
+                "textures/ui/store_sort_icon",
+                "path",
+                makeNextViewCallback()
+            );
+            break;
+        case View::OnlySub:
+            form.appendButton(
+                "过滤: >子领地<"_trf(player),
+                "textures/ui/store_sort_icon",
+                "path",
+                makeNextViewCallback()
+            );
+            break;
         }
+
+        // 视图只记录领地下标，按钮在翻到对应页时才生成
+        auto items = std::make_shared<std::vector<size_t>>(collect(view));
+        form.setDataSource(
+            items->size(),
+            [thiz = getThis(), items, localeCode = GetPlayerLocaleCodeFromSettings(player)](size_t index) {
+                auto const& land = thiz->mLands[(*items)[index]];
+                return PaginatedSimpleForm::ButtonData{
+                    "{}\n维度: {} | ID: {}"_trl(localeCode, land->getName(), land->getDimensionId(), land->getId()),
+                    "textures/ui/icon_recipe_nature",
+                    "path",
+                    thiz->makeCallback(land)
+                };
+            }
+        );
+        return form;
     }
 
     void sendFuzzySearch(Player& player) {
@@ -210,22 +222,29 @@ class ChooseLandAdvancedUtilGUI::Impl final {
             if (name.empty()) {
                 return thiz->sendFuzzySearch(self); // 重新发送
             }
+            // 只对当前列表中的领地打分，不搜索整个注册表
+            std::vector<LandID> ids;
+            ids.reserve(thiz->mLands.size());
+            for (auto const& land : thiz->mLands) {
+                ids.push_back(land->getId());
+            }
+            auto matches        = PLand::getInstance().getLandRegistry().fuzzyRankLands(name, ids);
             thiz->mFuzzyKeyword = name;
+            thiz->mFuzzyRank.emplace();
+            for (size_t i = 0; i < matches.size(); ++i) {
+                thiz->mFuzzyRank->emplace(matches[i].id, i);
+            }
             thiz->mViews.clear();
-            thiz->buildForms(self);
             thiz->sendView(self, thiz->mCurrentView);
         });
     }
 
     void sendView(Player& player, View view) {
         mCurrentView = view;
-        mViews.at(view).sendTo(player);
+        getView(player, view).sendTo(player);
     }
 
-    void sendTo(Player& player) {
-        buildForms(player);
-        sendView(player, View::All);
-    }
+    void sendTo(Player& player) { sendView(player, View::All); }
 };
 
 
@@ -33,6 +33,11 @@ class PaginatedFormWrapperImpl {
         return *this;
     }
 
+    PaginatedFormWrapperImpl& setDataSource(size_t count, PaginatedSimpleForm::ItemProvider provider) {
+        impl->setDataSource(count, std::move(provider));
+        return *this;
+    }
+
     // concept: HasSendToMethod
     template <typename... Args>
     void sendTo(Args&&... args) {
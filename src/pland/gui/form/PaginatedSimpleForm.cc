@@ -1,6 +1,7 @@
 #include "pland/gui/form/PaginatedSimpleForm.h"
 #include "ll/api/form/CustomForm.h"
 #include "mc/world/actor/player/Player.h"
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <utility>
@@ -72,9 +73,20 @@ PaginatedSimpleForm& PaginatedSimpleForm::appendButton(std::string text, SimpleF
     return *this;
 }
 
+PaginatedSimpleForm& PaginatedSimpleForm::setDataSource(size_t count, ItemProvider provider) {
+    mSourceCount    = provider ? count : 0;
+    mSourceProvider = std::move(provider);
+    mIsDirty        = true;
+    return *this;
+}
+
 void PaginatedSimpleForm::sendTo(Player& player) {
     buildSpecialButtons(player);
-    buildPages();
+    if (mIsDirty) {
+        mIsDirty = false;
+        mPage.reset();
+        _countPages();
+    }
     sendFirstPage(player);
 }
 
@@ -85,19 +97,21 @@ PaginatedSimpleForm& PaginatedSimpleForm::onFormCanceled(FormCanceledCallback cb
 
 
 // impl
-PaginatedSimpleForm::Page::Page(std::unique_ptr<SimpleForm> form, std::map<int, ButtonData const&> indexMap)
-: mForm(std::move(form)),
-  mIndexMap(std::move(indexMap)) {}
+PaginatedSimpleForm::Page::Page(std::unique_ptr<SimpleForm> form) : mForm(std::move(form)) {}
+void PaginatedSimpleForm::Page::append(ButtonData const& button) {
+    mForm->appendButton(button.mText, button.mImageData, button.mImageType);
+    mIndexMap.emplace(static_cast<int>(mIndexMap.size()), &button); // 记录按钮索引
+}
 void PaginatedSimpleForm::Page::sendTo(Player& player, SimpleForm::Callback cb) const {
     mForm->sendTo(player, std::move(cb));
 }
 void PaginatedSimpleForm::Page::inovkeCallback(Player& player, int index) const {
-    auto& res = mIndexMap.at(index);
-    if (res.mCallback) {
-        res.mCallback(player);
-    } else {
+    auto& res = *mIndexMap.at(index);
+    if (!res.mCallback) {
         throw std::runtime_error("no callback for button: " + res.mText);
     }
+    auto callback = res.mCallback; // 回调可能翻页并替换当前页，先复制一份
+    callback(player);
 }
 
 void PaginatedSimpleForm::buildSpecialButtons(Player& player) {
@@ -175,100 +189,71 @@ PaginatedSimpleForm::ButtonData const& PaginatedSimpleForm::getSpecialButton(Spe
 }
 
 PaginatedSimpleForm::Page& PaginatedSimpleForm::getPage(int pageNumber) {
-    int pageSize = static_cast<int>(mPages.size());
-    if (pageNumber > pageSize || pageNumber <= 0) {
+    if (pageNumber > mTotalPages || pageNumber <= 0) {
         throw std::runtime_error("Invalid page number: " + std::to_string(pageNumber));
     }
-    return mPages[pageNumber - 1];
-}
-
-void PaginatedSimpleForm::_countPages() {
-    mTotalPages = static_cast<int>(mButtons.size()) / mOptions.pageButtons;
-    if (mButtons.size() % mOptions.pageButtons != 0) {
-        mTotalPages++; // 如果按钮数量不能被页按钮数量整除，则增加一页(向上取整)
+    if (!mPage || mPageNumber != pageNumber) {
+        _buildPage(pageNumber);
     }
+    return *mPage;
 }
 
-void PaginatedSimpleForm::buildPages() {
-    if (!mIsDirty) {
-        return;
-    }
-    mIsDirty = false;
-    mPages.clear();
+size_t PaginatedSimpleForm::_itemCount() const { return mButtons.size() + mSourceCount; }
 
-    _countPages();
-
-    if (mTotalPages == 0) {
-        return;
-    }
-
-    // 创建页
-    for (int i = 1; i <= mTotalPages; i++) {
-        mPages.emplace_back(
-            std::make_unique<SimpleForm>(mTitle + "[{}/{}]"_tr(i, mTotalPages), mContent),
-            std::map<int, ButtonData const&>()
-        );
-    }
+void PaginatedSimpleForm::_countPages() {
+    auto count  = _itemCount();
+    auto size   = static_cast<size_t>(mOptions.pageButtons);
+    mTotalPages = static_cast<int>((count + size - 1) / size); // 向上取整
+}
 
-    // 将按钮分配到页
-    int counter     = 1;
-    int pageNumber  = 1;
-    int buttonIndex = 0;
-    for (auto const& button : mButtons) {
-        auto& page = getPage(pageNumber);
+void PaginatedSimpleForm::_buildPage(int pageNumber) {
+    auto size  = static_cast<size_t>(mOptions.pageButtons);
+    auto fixed = mButtons.size(); // appendButton 添加的按钮排在数据源之前
+    auto begin = static_cast<size_t>(pageNumber - 1) * size;
+    auto end   = std::min(begin + size, _itemCount());
+    auto first = std::max(begin, fixed); // 本页第一个数据源按钮
 
-        if (counter == 1) {
-            _beginBuild(page, pageNumber, buttonIndex);
-        }
+    Page page{std::make_unique<SimpleForm>(mTitle + "[{}/{}]"_tr(pageNumber, mTotalPages), mContent)};
 
-        page.mForm->appendButton(button.mText, button.mImageData, button.mImageType);
-        page.mIndexMap.emplace(buttonIndex++, button); // 记录按钮索引
-
-        ++counter;
-        if (counter > mOptions.pageButtons) {
-            _endBuild(page, pageNumber, buttonIndex);
-            pageNumber++;
-            counter     = 1;
-            buttonIndex = 0;
+    // 只生成本页的数据源按钮，预留容量保证 mIndexMap 中的指针不失效
+    if (end > first) {
+        page.mItems.reserve(end - first);
+        for (auto i = first; i < end; ++i) {
+            page.mItems.push_back(mSourceProvider(i - fixed));
         }
     }
 
-    if (counter > 1 && counter < mOptions.pageButtons) {
-        _endBuild(getPage(pageNumber), pageNumber, buttonIndex);
+    _beginBuild(page, pageNumber);
+    for (auto i = begin; i < end; ++i) {
+        page.append(i < fixed ? mButtons[i] : page.mItems[i - first]);
     }
+    _endBuild(page, pageNumber);
+
+    mPage       = std::make_unique<Page>(std::move(page));
+    mPageNumber = pageNumber;
 }
-void PaginatedSimpleForm::_beginBuild(Page& page, int pageNumber, int& buttonIndex) {
+void PaginatedSimpleForm::_beginBuild(Page& page, int pageNumber) {
     if (pageNumber != 1 && mTotalPages != 1) { // 非第一页 && 总页数大于1
-        auto& prev = getSpecialButton(SpecialButton::PrevPage);
-        page.mForm->appendButton(prev.mText, prev.mImageData, prev.mImageType);
-        page.mIndexMap.emplace(buttonIndex++, prev); // 记录按钮索引
+        page.append(getSpecialButton(SpecialButton::PrevPage));
     }
 }
-void PaginatedSimpleForm::_endBuild(Page& page, int pageNumber, int& buttonIndex) {
+void PaginatedSimpleForm::_endBuild(Page& page, int pageNumber) {
     if (pageNumber != mTotalPages) {
         // 不是最后一页，添加下一页按钮
-        auto& next = getSpecialButton(SpecialButton::NextPage);
-        page.mForm->appendButton(next.mText, next.mImageData, next.mImageType);
-        page.mIndexMap.emplace(buttonIndex++, next); // 记录按钮索引
+        page.append(getSpecialButton(SpecialButton::NextPage));
     }
 
     if (mOptions.enableJumpFirstOrLast) {
         if (pageNumber != 1) {
-            auto& first = getSpecialButton(SpecialButton::JumpToFirstPage);
-            page.mForm->appendButton(first.mText, first.mImageData, first.mImageType);
-            page.mIndexMap.emplace(buttonIndex++, first); // 记录按钮索引
+            page.append(getSpecialButton(SpecialButton::JumpToFirstPage));
         }
 
         if (mOptions.enableJumpSpecial) {
-            auto& jump = getSpecialButton(SpecialButton::Special);
-            page.mForm->appendButton(jump.mText, jump.mImageData, jump.mImageType);
-            page.mIndexMap.emplace(buttonIndex++, jump); // 记录按钮索引
+            page.append(getSpecialButton(SpecialButton::Special));
         }
 
         if (pageNumber != mTotalPages) {
-            auto& last = getSpecialButton(SpecialButton::JumpToLastPage);
-            page.mForm->appendButton(last.mText, last.mImageData, last.mImageType);
-            page.mIndexMap.emplace(buttonIndex++, last); // 记录按钮索引
+            page.append(getSpecialButton(SpecialButton::JumpToLastPage));
         }
     }
 }
@@ -294,7 +279,7 @@ void PaginatedSimpleForm::sendPrevPage(Player& player) {
     }
 }
 void PaginatedSimpleForm::sendNextPage(Player& player) {
-    if (mCurrentPageNumber >= static_cast<int>(mPages.size())) {
+    if (mCurrentPageNumber >= mTotalPages) {
         getPage(mCurrentPageNumber).sendTo(player, makeCallback());
     } else {
         getPage(++mCurrentPageNumber).sendTo(player, makeCallback());
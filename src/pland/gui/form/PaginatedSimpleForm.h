@@ -2,6 +2,8 @@
 #include "ll/api/form/CustomForm.h"
 #include "ll/api/form/SimpleForm.h"
 #include "pland/Global.h"
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
 #include <utility>
@@ -24,6 +26,29 @@ class PaginatedSimpleForm : public std::enable_shared_from_this<PaginatedSimpleF
 
     using FormCanceledCallback = std::function<void(Player& player)>;
 
+    struct ButtonData {
+        std::string                mText;
+        std::string                mImageData;
+        std::string                mImageType;
+        SimpleForm::ButtonCallback mCallback;
+
+        LD_DISABLE_COPY(ButtonData);
+        ButtonData(ButtonData&&) noexcept            = default;
+        ButtonData& operator=(ButtonData&&) noexcept = default;
+        LDAPI explicit ButtonData(std::string text, SimpleForm::ButtonCallback callback = {});
+        LDAPI explicit ButtonData(
+            std::string                text,
+            std::string                imageData,
+            std::string                imageType,
+            SimpleForm::ButtonCallback callback = {}
+        );
+    };
+
+    /**
+     * @brief 数据源按钮生成器，参数为数据源内的下标
+     */
+    using ItemProvider = std::function<ButtonData(size_t index)>;
+
 public:
     template <typename... Args>
     static std::shared_ptr<PaginatedSimpleForm> make(Args&&... args) {
@@ -45,6 +70,15 @@ class PaginatedSimpleForm : public std::enable_shared_from_this<PaginatedSimpleF
 
     LDAPI PaginatedSimpleForm& appendButton(std::string text, SimpleForm::ButtonCallback callback = {});
 
+    /**
+     * @brief 设置数据源，数据源按钮排在 appendButton 添加的按钮之后
+     * 只在发送某一页时生成该页的按钮，翻页/跳页的开销只与每页按钮数有关；
+     * 搜索、排序等可在调用方对下标数组完成，provider 再按下标取数据
+     * @param count    数据源按钮数量
+     * @param provider 按下标生成按钮
+     */
+    LDAPI PaginatedSimpleForm& setDataSource(size_t count, ItemProvider provider);
+
     LDAPI void sendTo(Player& player);
 
     /**
@@ -59,24 +93,6 @@ class PaginatedSimpleForm : public std::enable_shared_from_this<PaginatedSimpleF
     LDAPI explicit PaginatedSimpleForm(std::string title, std::string content, Options options);
 
 
-    struct ButtonData {
-        std::string                mText;
-        std::string                mImageData;
-        std::string                mImageType;
-        SimpleForm::ButtonCallback mCallback;
-
-        LD_DISABLE_COPY(ButtonData);
-        ButtonData(ButtonData&&) noexcept            = default;
-        ButtonData& operator=(ButtonData&&) noexcept = default;
-        LDAPI explicit ButtonData(std::string text, SimpleForm::ButtonCallback callback = {});
-        LDAPI explicit ButtonData(
-            std::string                text,
-            std::string                imageData,
-            std::string                imageType,
-            SimpleForm::ButtonCallback callback = {}
-        );
-    };
-
     enum class SpecialButton {
         PrevPage,        // 上一页
         NextPage,        // 下一页
@@ -87,7 +103,8 @@ class PaginatedSimpleForm : public std::enable_shared_from_this<PaginatedSimpleF
 
     class Page final {
         std::unique_ptr<SimpleForm>      mForm;     // 表单数据
-        std::map<int, ButtonData const&> mIndexMap; // 按钮索引映射
+        std::vector<ButtonData>          mItems;    // 本页生成的数据源按钮
+        std::map<int, ButtonData const*> mIndexMap; // 按钮索引映射
 
         friend PaginatedSimpleForm;
 
@@ -95,7 +112,8 @@ class PaginatedSimpleForm : public std::enable_shared_from_this<PaginatedSimpleF
         LD_DISABLE_COPY(Page);
         Page(Page&&) noexcept            = default;
         Page& operator=(Page&&) noexcept = default;
-        Page(std::unique_ptr<SimpleForm> form, std::map<int, ButtonData const&> indexMap);
+        explicit Page(std::unique_ptr<SimpleForm> form);
+        void append(ButtonData const& button); // 追加按钮，索引按追加顺序递增
         void sendTo(Player& player, SimpleForm::Callback cb) const;
         void inovkeCallback(Player& player, int index) const;
     };
@@ -104,12 +122,13 @@ class PaginatedSimpleForm : public std::enable_shared_from_this<PaginatedSimpleF
     void              buildSpecialButtons(Player& player);
     ButtonData const& getSpecialButton(SpecialButton specialButton);
 
-    Page& getPage(int pageNumber);
+    Page& getPage(int pageNumber); // 获取页，仅缓存最近生成的一页
 
-    void buildPages(); // 生成分页表单数据
-    void _countPages();
-    void _beginBuild(Page& page, int pageNumber, int& buttonIndex);
-    void _endBuild(Page& page, int pageNumber, int& buttonIndex);
+    void   _countPages();
+    size_t _itemCount() const;
+    void   _buildPage(int pageNumber); // 生成指定页到 mPage
+    void   _beginBuild(Page& page, int pageNumber);
+    void   _endBuild(Page& page, int pageNumber);
 
     SimpleForm::Callback makeCallback(); // 创建回调函数
 
@@ -129,14 +148,17 @@ class PaginatedSimpleForm : public std::enable_shared_from_this<PaginatedSimpleF
     std::string                         mTitle;            // 表单标题
     std::string                         mContent;          // 表单内容
     std::vector<ButtonData>             mButtons;          // 按钮数据
+    size_t                              mSourceCount{0};   // 数据源按钮数量
+    ItemProvider                        mSourceProvider{}; // 数据源按钮生成器
     std::map<SpecialButton, ButtonData> mSpecialButtons;   // 特殊按钮数据
     bool                                mIsDirty{true};    // 是否需要重新生成表单
     FormCanceledCallback                mFormCanceledCb{}; // 表单取消回调函数
 
     // 表单数据(分页)
-    std::vector<Page> mPages;                // 分页表单数据
-    int               mTotalPages{0};        // 总页数
-    int               mCurrentPageNumber{1}; // 当前页码(从1开始)
+    std::unique_ptr<Page> mPage{nullptr};        // 最近生成的页
+    int                   mPageNumber{0};        // mPage 的页码
+    int                   mTotalPages{0};        // 总页数
+    int                   mCurrentPageNumber{1}; // 当前页码(从1开始)
 };
 
 
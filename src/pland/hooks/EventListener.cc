@@ -1,5 +1,6 @@
 
 #include "pland/hooks/EventListener.h"
+#include "pland/hooks/optimize/MobDamageTable.h"
 #include "ll/api/event/EventBus.h"
 #include <functional>
 
@@ -7,6 +8,9 @@
 namespace land {
 
 EventListener::EventListener() {
+    // 监听器随配置重载重建，分类表在此同步重建
+    MobDamageTable::rebuild();
+
     // 调用所有分类的注册函数
     registerLLSessionListeners();
 
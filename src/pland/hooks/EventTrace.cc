@@ -0,0 +1,166 @@
+#include "pland/hooks/EventTrace.h"
+#include "pland/PLand.h"
+
+#include "nlohmann/json.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+namespace land {
+
+namespace {
+
+// map 节点地址稳定，EventNames 直接指向其中的键
+std::map<std::string, uint16_t, std::less<>> EventIds;
+std::vector<std::string const*>              EventNames;
+std::mutex                                   EventNamesMutex;
+
+// 记录打包格式:
+// word0: timestamp
+// word1: event(16) | verdict(8) | hasPos(8) | dimid(32)
+// word2: x(32) | z(32)
+// word3: y(32)
+// word4: land
+uint64_t packPair(int32_t low, int32_t high) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(low)) | static_cast<uint64_t>(static_cast<uint32_t>(high)) << 32;
+}
+int32_t unpackLow(uint64_t word) { return static_cast<int32_t>(static_cast<uint32_t>(word)); }
+int32_t unpackHigh(uint64_t word) { return static_cast<int32_t>(static_cast<uint32_t>(word >> 32)); }
+
+uint64_t nowMicros() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count()
+    );
+}
+
+} // namespace
+
+
+EventTrace& EventTrace::_instance() {
+    static EventTrace instance;
+    return instance;
+}
+
+void EventTrace::setSampleRate(uint32_t rate) { mSampleRate.store(rate, std::memory_order_relaxed); }
+
+uint32_t EventTrace::getSampleRate() { return mSampleRate.load(std::memory_order_relaxed); }
+
+uint16_t EventTrace::intern(std::string_view name) {
+    std::lock_guard lock(EventNamesMutex);
+    if (auto iter = EventIds.find(name); iter != EventIds.end()) {
+        return iter->second;
+    }
+    auto id   = static_cast<uint16_t>(EventNames.size());
+    auto iter = EventIds.emplace(std::string{name}, id).first;
+    EventNames.push_back(&iter->first);
+    return id;
+}
+
+std::string_view EventTrace::eventName(uint16_t event) {
+    std::lock_guard lock(EventNamesMutex);
+    if (event >= EventNames.size()) {
+        return "unknown";
+    }
+    return *EventNames[event];
+}
+
+void EventTrace::record(uint16_t event, ListenerOutcome verdict, int dimid, BlockPos const* pos, LandID land) {
+    auto& self  = _instance();
+    auto  index = self.mHead.fetch_add(1, std::memory_order_relaxed);
+    auto& slot  = self.mSlots[index & (Capacity - 1)];
+
+    auto flags  = event | static_cast<int32_t>(verdict) << 16 | static_cast<int32_t>(pos != nullptr) << 24;
+    auto header = packPair(flags, dimid);
+
+    slot.seq.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.words[0].store(nowMicros(), std::memory_order_relaxed);
+    slot.words[1].store(header, std::memory_order_relaxed);
+    slot.words[2].store(pos ? packPair(pos->x, pos->z) : 0, std::memory_order_relaxed);
+    slot.words[3].store(pos ? static_cast<uint32_t>(pos->y) : 0, std::memory_order_relaxed);
+    slot.words[4].store(static_cast<uint64_t>(land), std::memory_order_relaxed);
+    slot.seq.store(index * 2 + 2, std::memory_order_release);
+}
+
+std::vector<EventTrace::Record> EventTrace::snapshot() {
+    auto& self = _instance();
+    auto  head = self.mHead.load(std::memory_order_acquire);
+    auto  from = head > Capacity ? head - Capacity : 0;
+
+    std::vector<Record> result;
+    result.reserve(head - from);
+    for (auto index = from; index < head; ++index) {
+        auto& slot = self.mSlots[index & (Capacity - 1)];
+
+        auto before = slot.seq.load(std::memory_order_acquire);
+        if (before != index * 2 + 2) {
+            continue; // 正在写入或已被覆盖
+        }
+        std::array<uint64_t, 5> words;
+        for (size_t i = 0; i < words.size(); ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+
+        result.push_back(Record{
+            .timestamp = words[0],
+            .event     = static_cast<uint16_t>(words[1]),
+            .verdict   = static_cast<ListenerOutcome>(words[1] >> 16 & 0xFF),
+            .hasPos    = (words[1] >> 24 & 0xFF) != 0,
+            .dimid     = unpackHigh(words[1]),
+            .pos       = BlockPos{unpackLow(words[2]), unpackLow(words[3]), unpackHigh(words[2])},
+            .land      = static_cast<LandID>(words[4])
+        });
+    }
+    return result;
+}
+
+void EventTrace::clear() {
+    auto& self = _instance();
+    for (auto& slot : self.mSlots) {
+        slot.seq.store(0, std::memory_order_relaxed);
+    }
+    self.mHead.store(0, std::memory_order_release);
+}
+
+ll::Expected<std::filesystem::path> EventTrace::dump() {
+    auto path = PLand::getInstance().getSelf().getDataDir() / "event_trace.json";
+
+    auto records = snapshot();
+    auto json    = nlohmann::json::array();
+    for (auto const& record : records) {
+        static constexpr char const* Verdicts[] = {"pass", "skip", "cancel"};
+
+        auto entry       = nlohmann::json::object();
+        entry["time"]    = record.timestamp;
+        entry["event"]   = std::string{eventName(record.event)};
+        entry["verdict"] = Verdicts[static_cast<size_t>(record.verdict)];
+        entry["dimid"]   = record.dimid;
+        if (record.hasPos) {
+            entry["pos"] = {record.pos.x, record.pos.y, record.pos.z};
+        }
+        if (record.land != NoLand) {
+            entry["land"] = record.land;
+        }
+        json.push_back(std::move(entry));
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) {
+        return ll::makeStringError(fmt::format("Failed to open file: {}", path.string()));
+    }
+    file << json.dump(4);
+    if (!file) {
+        return ll::makeStringError(fmt::format("Failed to write file: {}", path.string()));
+    }
+    return path;
+}
+
+
+} // namespace land
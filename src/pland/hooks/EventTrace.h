@@ -0,0 +1,140 @@
+#pragma once
+#include "pland/Global.h"
+
+#include "ll/api/Expected.h"
+
+#include "mc/world/level/BlockPos.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace land {
+
+
+enum class ListenerOutcome : uint8_t {
+    Pass,   // 放行(检查了权限)
+    Skip,   // 跳过(无需检查)
+    Cancel, // 拦截
+};
+
+/**
+ * @brief 采样事件追踪
+ *
+ * 按 1/N 采样记录事件的紧凑记录(事件、位置、维度、领地、结果)到固定容量的无锁环形缓冲区，
+ * 新记录覆盖最旧的记录，需要时导出，不产生日志输出。
+ * 每个槽位使用序列号(seqlock)保护，写入方之间无锁，读取方跳过正在写入的槽位。
+ */
+class EventTrace final {
+public:
+    static constexpr uint32_t Capacity = 8192; // 环形缓冲区容量(2 的幂)
+    static constexpr LandID   NoLand   = -1;   // 未查询领地/不在领地内
+    static constexpr int      NoDimid  = -1;   // 未知维度
+
+    struct Record {
+        uint64_t        timestamp; // Unix 时间(微秒)
+        uint16_t        event;     // intern() 返回的事件编号
+        ListenerOutcome verdict;   // 结果
+        bool            hasPos;    // 是否记录了位置
+        int             dimid;     // 维度
+        BlockPos        pos;       // 位置
+        LandID          land;      // 领地ID
+    };
+
+private:
+    struct Slot {
+        std::atomic<uint64_t>                seq{0};  // 奇数: 写入中, 偶数: 已完成
+        std::array<std::atomic<uint64_t>, 5> words{}; // 打包后的记录
+    };
+
+    std::array<Slot, Capacity> mSlots;
+    std::atomic<uint64_t>      mHead{0};
+
+    inline static std::atomic<uint32_t> mSampleRate{0}; // 0 为关闭
+
+    static EventTrace& _instance();
+
+public:
+    LD_DISABLE_COPY_AND_MOVE(EventTrace);
+    explicit EventTrace() = default;
+
+    [[nodiscard]] static bool isEnabled() { return mSampleRate.load(std::memory_order_relaxed) != 0; }
+
+    /**
+     * @brief 判断本次事件是否需要采样(每个线程独立计数)
+     */
+    [[nodiscard]] static bool shouldSample() {
+        auto rate = mSampleRate.load(std::memory_order_relaxed);
+        if (rate == 0) {
+            return false;
+        }
+        thread_local uint32_t counter = 0;
+        if (++counter < rate) {
+            return false;
+        }
+        counter = 0;
+        return true;
+    }
+
+    /**
+     * @brief 设置采样率，每 rate 个事件记录 1 个，0 为关闭
+     */
+    LDAPI static void setSampleRate(uint32_t rate);
+
+    LDNDAPI static uint32_t getSampleRate();
+
+    /**
+     * @brief 注册事件名，返回紧凑编号(同名返回相同编号)
+     */
+    LDNDAPI static uint16_t intern(std::string_view name);
+
+    LDNDAPI static std::string_view eventName(uint16_t event);
+
+    LDAPI static void record(uint16_t event, ListenerOutcome verdict, int dimid, BlockPos const* pos, LandID land);
+
+    /**
+     * @brief 按时间顺序取出缓冲区内的记录(不清空)
+     */
+    LDNDAPI static std::vector<Record> snapshot();
+
+    LDAPI static void clear();
+
+    /**
+     * @brief 导出缓冲区到数据目录下的 JSON 文件
+     * @return 导出文件路径
+     */
+    LDNDAPI static ll::Expected<std::filesystem::path> dump();
+};
+
+/**
+ * @brief 从事件中尽可能提取维度与位置并记录(用于未声明定位方式的监听器)
+ */
+template <typename E>
+void traceEvent(uint16_t event, ListenerOutcome verdict, E& ev) {
+    int dimid = EventTrace::NoDimid;
+    if constexpr (requires { ev.blockSource().getDimensionId(); }) {
+        dimid = ev.blockSource().getDimensionId();
+    } else if constexpr (requires { ev.self().getDimensionId(); }) {
+        dimid = ev.self().getDimensionId();
+    }
+
+    if constexpr (requires { BlockPos{ev.pos()}; }) {
+        BlockPos pos{ev.pos()};
+        EventTrace::record(event, verdict, dimid, &pos, EventTrace::NoLand);
+    } else if constexpr (requires { BlockPos{ev.blockPos()}; }) {
+        BlockPos pos{ev.blockPos()};
+        EventTrace::record(event, verdict, dimid, &pos, EventTrace::NoLand);
+    } else if constexpr (requires { BlockPos{ev.self().getPosition()}; }) {
+        BlockPos pos{ev.self().getPosition()};
+        EventTrace::record(event, verdict, dimid, &pos, EventTrace::NoLand);
+    } else {
+        EventTrace::record(event, verdict, dimid, nullptr, EventTrace::NoLand);
+    }
+}
+
+
+} // namespace land
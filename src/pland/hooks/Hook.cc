@@ -1,6 +1,7 @@
 #include "pland/Global.h"
 #include "pland/PLand.h"
 #include "pland/hooks/EventListener.h"
+#include "pland/hooks/ListenerStats.h"
 #include "pland/hooks/listeners/ListenerHelper.h"
 #include "pland/infra/Config.h"
 #include "pland/land/LandRegistry.h"
@@ -37,11 +38,18 @@ LL_TYPE_INSTANCE_HOOK(
     bool                       knock,
     bool                       ignite
 ) {
+    static auto&         stats = ListenerStats::get("MobHurtHook");
+    ListenerStats::Scope scope{stats};
+
     ll::event::ActorHurtEvent ev{*this, source, damage, knock, ignite};
+    scope.pause(); // 事件监听器已单独统计
     ll::event::EventBus::getInstance().publish(ev);
+    scope.resume();
     if (ev.isCancelled()) {
+        scope.finish(ListenerOutcome::Cancel);
         return false;
     }
+    scope.finish(ListenerOutcome::Pass);
     return origin(source, damage, knock, ignite);
 }
 
@@ -55,6 +63,9 @@ LL_TYPE_INSTANCE_HOOK(
     Actor& inEntity,
     float  inSpeed
 ) {
+    static auto&         stats = ListenerStats::get("FishingHookHitHook");
+    ListenerStats::Scope scope{stats};
+
     // 获取钓鱼钩的位置和维度
     auto& hookActor = *this;
     auto& pos       = hookActor.getPosition();
@@ -66,6 +77,7 @@ LL_TYPE_INSTANCE_HOOK(
 
     auto* player = hookActor.getPlayerOwner();
     if (!player) {
+        scope.finish(ListenerOutcome::Skip);
         origin(inEntity, inSpeed);
         return;
     }
@@ -75,14 +87,17 @@ LL_TYPE_INSTANCE_HOOK(
         // 检查玩家是否有权限
         if (!PreCheckLandExistsAndPermission(land, player->getUuid())) {
             // 领地不存在或玩家没有权限，则拦截
+            scope.finish(ListenerOutcome::Cancel);
             return;
         }
         // 检查钓鱼竿权限
         if (!land->getPermTable().allowFishingRodAndHook) {
             // 如果不允许使用钓鱼竿，则拦截
+            scope.finish(ListenerOutcome::Cancel);
             return;
         }
     }
+    scope.finish(land ? ListenerOutcome::Pass : ListenerOutcome::Skip);
     origin(inEntity, inSpeed);
 }
 
@@ -96,14 +111,19 @@ LL_TYPE_INSTANCE_HOOK(
     ::BlockSource&    region,
     ::BlockPos const& pos
 ) {
+    static auto&         stats = ListenerStats::get("LayEggGoalHook");
+    ListenerStats::Scope scope{stats};
+
     // 获取领地注册表实例
     auto& db   = PLand::getInstance().getLandRegistry();
     auto  land = db.getLandAt(pos, region.getDimensionId());
 
     // 如果在领地内且不允许实体破坏，则阻止产蛋
     if (land && !land->getPermTable().allowActorDestroy) {
+        scope.finish(ListenerOutcome::Cancel);
         return false;
     }
+    scope.finish(land ? ListenerOutcome::Pass : ListenerOutcome::Skip);
     return origin(region, pos);
 }
 
@@ -121,14 +141,19 @@ LL_TYPE_INSTANCE_HOOK(
     int               age,
     ::BlockPos const& firePos
 ) {
+    static auto&         stats = ListenerStats::get("FireBlockBurnHook");
+    ListenerStats::Scope scope{stats};
+
     // 获取领地注册表实例
     auto& db   = PLand::getInstance().getLandRegistry();
     auto  land = db.getLandAt(pos, region.getDimensionId());
 
     // 如果在领地内且不允许火焰蔓延，则拦截
     if (land && !land->getPermTable().allowFireSpread) {
+        scope.finish(ListenerOutcome::Cancel);
         return;
     }
+    scope.finish(land ? ListenerOutcome::Pass : ListenerOutcome::Skip);
     origin(region, pos, chance, randomize, age, firePos);
 }
 
@@ -142,7 +167,11 @@ LL_TYPE_INSTANCE_HOOK(
     void,
     ::Actor& actor
 ) {
+    static auto&         stats = ListenerStats::get("ChestBlockActorOpenHook");
+    ListenerStats::Scope scope{stats};
+
     if (actor.isPlayer()) {
+        scope.finish(ListenerOutcome::Skip);
         origin(actor);
         return;
     }
@@ -151,8 +180,10 @@ LL_TYPE_INSTANCE_HOOK(
     auto  land = db.getLandAt(this->mPosition, actor.getDimensionId());
 
     if (land && !land->getPermTable().allowOpenChest) {
+        scope.finish(ListenerOutcome::Cancel);
         return;
     }
+    scope.finish(land ? ListenerOutcome::Pass : ListenerOutcome::Skip);
     origin(actor);
 }
 
@@ -0,0 +1,229 @@
+#include "pland/hooks/ListenerStats.h"
+#include "pland/PLand.h"
+#include "pland/utils/JsonUtil.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define LD_HAS_RDTSC 1
+#endif
+
+namespace land {
+
+namespace {
+
+std::map<std::string, std::unique_ptr<ListenerStats>, std::less<>> StatsRegistry;
+std::mutex                                                         StatsRegistryMutex;
+
+uint64_t steadyNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count()
+    );
+}
+
+// TSC 校准基准点，读取统计时用两点间的 TSC 差 / 纳秒差得到频率
+struct ClockBase {
+    uint64_t ticks = ListenerStats::now();
+    uint64_t ns    = steadyNs();
+};
+ClockBase const& clockBase() {
+    static ClockBase const base;
+    return base;
+}
+
+constexpr uint64_t MinCalibrationNs = 10'000'000; // 校准间隔过短时频率误差较大
+
+// 距基准点不足校准间隔时返回空(仅在插件启用后的极短时间内)，不在调用线程上等待
+std::optional<double> ticksPerNs() {
+#ifdef LD_HAS_RDTSC
+    auto const& base    = clockBase();
+    auto        ns      = steadyNs();
+    auto        ticks   = ListenerStats::now();
+    auto        elapsed = ns - base.ns;
+    if (elapsed < MinCalibrationNs) {
+        return std::nullopt;
+    }
+    return static_cast<double>(ticks - base.ticks) / static_cast<double>(elapsed);
+#else
+    return 1.0;
+#endif
+}
+
+template <typename T>
+void atomicMax(std::atomic<T>& target, T value) {
+    auto current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+} // namespace
+
+
+ListenerStats::ListenerStats(std::string name) : mName(std::move(name)) {}
+
+size_t ListenerStats::_shardIndex() {
+    static std::atomic<size_t> next{0};
+    thread_local size_t const  index = next.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+    return index;
+}
+
+uint32_t ListenerStats::_bucketIndex(uint64_t ticks) {
+    if (ticks < SubBucketCount) {
+        return static_cast<uint32_t>(ticks);
+    }
+    auto magnitude = static_cast<uint32_t>(std::bit_width(ticks)) - 1; // >= SubBucketBits
+    if (magnitude >= MaxMagnitude) {
+        return BucketCount - 1;
+    }
+    auto sub = static_cast<uint32_t>(ticks >> (magnitude - SubBucketBits)) & (SubBucketCount - 1);
+    return (magnitude - SubBucketBits + 1) * SubBucketCount + sub;
+}
+
+uint64_t ListenerStats::_bucketValue(uint32_t index) {
+    if (index < SubBucketCount) {
+        return index;
+    }
+    auto magnitude = index / SubBucketCount + SubBucketBits - 1;
+    auto sub       = index % SubBucketCount;
+    auto width     = uint64_t{1} << (magnitude - SubBucketBits);
+    return ((SubBucketCount + sub) << (magnitude - SubBucketBits)) + width / 2; // 取桶中点
+}
+
+void ListenerStats::setEnabled(bool enabled) {
+    (void)clockBase(); // 插件启用时即确定校准基准，读取统计时通常已校准完成
+    mEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool ListenerStats::isCalibrated() { return ticksPerNs().has_value(); }
+
+uint64_t ListenerStats::now() {
+#ifdef LD_HAS_RDTSC
+    return __rdtsc();
+#else
+    return steadyNs();
+#endif
+}
+
+ListenerStats& ListenerStats::get(std::string_view name) {
+    std::lock_guard lock(StatsRegistryMutex);
+    if (auto iter = StatsRegistry.find(name); iter != StatsRegistry.end()) {
+        return *iter->second;
+    }
+    auto stats = std::make_unique<ListenerStats>(std::string{name});
+    return *StatsRegistry.emplace(std::string{name}, std::move(stats)).first->second;
+}
+
+void ListenerStats::record(ListenerOutcome outcome, uint64_t ticks) {
+    auto& shard = mShards[_shardIndex()];
+    shard.outcomes[static_cast<size_t>(outcome)].fetch_add(1, std::memory_order_relaxed);
+    shard.totalTicks.fetch_add(ticks, std::memory_order_relaxed);
+    shard.buckets[_bucketIndex(ticks)].fetch_add(1, std::memory_order_relaxed);
+    atomicMax(shard.maxTicks, ticks);
+}
+
+ListenerStats::Snapshot ListenerStats::snapshot(double ratio) const {
+    Snapshot result{.name = mName};
+
+    uint64_t                          totalTicks = 0;
+    uint64_t                          maxTicks   = 0;
+    std::array<uint64_t, BucketCount> buckets{};
+    for (auto const& shard : mShards) {
+        result.pass   += shard.outcomes[static_cast<size_t>(ListenerOutcome::Pass)].load(std::memory_order_relaxed);
+        result.skip   += shard.outcomes[static_cast<size_t>(ListenerOutcome::Skip)].load(std::memory_order_relaxed);
+        result.cancel += shard.outcomes[static_cast<size_t>(ListenerOutcome::Cancel)].load(std::memory_order_relaxed);
+        totalTicks    += shard.totalTicks.load(std::memory_order_relaxed);
+        maxTicks       = std::max(maxTicks, shard.maxTicks.load(std::memory_order_relaxed));
+        for (uint32_t i = 0; i < BucketCount; ++i) {
+            buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+    result.calls = result.pass + result.skip + result.cancel;
+    if (result.calls == 0) {
+        return result;
+    }
+
+    auto toNs = [ratio](uint64_t ticks) { return static_cast<uint64_t>(static_cast<double>(ticks) / ratio); };
+
+    auto percentile = [&](double p) {
+        auto     threshold = static_cast<uint64_t>(static_cast<double>(result.calls) * p);
+        uint64_t seen      = 0;
+        for (uint32_t i = 0; i < BucketCount; ++i) {
+            seen += buckets[i];
+            if (seen > threshold) {
+                return toNs(std::min(_bucketValue(i), maxTicks));
+            }
+        }
+        return toNs(maxTicks);
+    };
+
+    result.totalNs = toNs(totalTicks);
+    result.meanNs  = result.totalNs / result.calls;
+    result.p50Ns   = percentile(0.50);
+    result.p90Ns   = percentile(0.90);
+    result.p99Ns   = percentile(0.99);
+    result.maxNs   = toNs(maxTicks);
+    return result;
+}
+
+std::vector<ListenerStats::Snapshot> ListenerStats::collect() {
+    auto const ratio = ticksPerNs();
+    if (!ratio) {
+        return {}; // 校准中
+    }
+
+    std::vector<Snapshot> result;
+    {
+        std::lock_guard lock(StatsRegistryMutex);
+        result.reserve(StatsRegistry.size());
+        for (auto const& [name, stats] : StatsRegistry) {
+            result.push_back(stats->snapshot(*ratio));
+        }
+    }
+    std::sort(result.begin(), result.end(), [](Snapshot const& a, Snapshot const& b) {
+        return a.totalNs > b.totalNs;
+    });
+    return result;
+}
+
+void ListenerStats::reset() {
+    std::lock_guard lock(StatsRegistryMutex);
+    for (auto& [name, stats] : StatsRegistry) {
+        for (auto& shard : stats->mShards) {
+            for (auto& counter : shard.outcomes) counter.store(0, std::memory_order_relaxed);
+            for (auto& counter : shard.buckets) counter.store(0, std::memory_order_relaxed);
+            shard.totalTicks.store(0, std::memory_order_relaxed);
+            shard.maxTicks.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+ll::Expected<std::filesystem::path> ListenerStats::dump() {
+    if (!isCalibrated()) {
+        return ll::makeStringError("Clock calibration in progress, try again later");
+    }
+    auto path = PLand::getInstance().getSelf().getDataDir() / "listener_stats.json";
+
+    auto snapshots = collect();
+    auto json      = json_util::struct2json(snapshots);
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) {
+        return ll::makeStringError(fmt::format("Failed to open file: {}", path.string()));
+    }
+    file << json.dump(4);
+    if (!file) {
+        return ll::makeStringError(fmt::format("Failed to write file: {}", path.string()));
+    }
+    return path;
+}
+
+
+} // namespace land
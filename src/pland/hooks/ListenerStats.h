@@ -0,0 +1,203 @@
+#pragma once
+#include "pland/Global.h"
+#include "pland/hooks/EventTrace.h"
+
+#include "ll/api/Expected.h"
+#include "ll/api/event/EventBus.h"
+#include "ll/api/event/EventId.h"
+#include "ll/api/event/ListenerBase.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace land {
+
+
+/**
+ * @brief 监听器/Hook 性能统计
+ *
+ * 每个监听器一份，记录调用次数、放行/跳过/拦截次数与耗时直方图(HDR 风格的对数-线性分桶)。
+ * 计数按线程分片累加，读取时合并；计时使用 TSC，读取时再换算为纳秒。
+ * 统计可在运行时开关，关闭时回调只多一次 relaxed load。
+ */
+class ListenerStats final {
+public:
+    // 直方图：每个 2 的幂区间细分 16 档(相对误差约 6%)，超出 2^MaxMagnitude 个周期的样本计入最后一档
+    static constexpr uint32_t SubBucketBits  = 4;
+    static constexpr uint32_t SubBucketCount = 1u << SubBucketBits;
+    static constexpr uint32_t MaxMagnitude   = 40;
+    static constexpr uint32_t BucketCount    = (MaxMagnitude - SubBucketBits + 1) * SubBucketCount;
+
+    static constexpr uint32_t ShardCount = 4; // 线程分片数
+
+    struct Snapshot {
+        std::string name;
+        uint64_t    calls{0};
+        uint64_t    pass{0};
+        uint64_t    skip{0};
+        uint64_t    cancel{0};
+        uint64_t    totalNs{0};
+        uint64_t    meanNs{0};
+        uint64_t    p50Ns{0};
+        uint64_t    p90Ns{0};
+        uint64_t    p99Ns{0};
+        uint64_t    maxNs{0};
+    };
+
+    /**
+     * @brief 计时作用域，用于 Hook 等无法包装回调的场景
+     * 析构(或 finish)时记录一次样本，统计关闭时不读取时钟
+     */
+    class Scope {
+        ListenerStats* mStats;
+        uint64_t       mBegin;
+
+    public:
+        LD_DISABLE_COPY_AND_MOVE(Scope);
+        explicit Scope(ListenerStats& stats)
+        : mStats(isEnabled() ? &stats : nullptr),
+          mBegin(mStats ? now() : 0) {}
+
+        ~Scope() { finish(ListenerOutcome::Pass); }
+
+        void finish(ListenerOutcome outcome) {
+            if (mStats) {
+                mStats->record(outcome, now() - mBegin);
+                mStats = nullptr;
+            }
+        }
+
+        /**
+         * @brief 暂停计时，用于排除已单独统计的嵌套调用(如发布事件)
+         * @note 暂停期间 mBegin 保存已计时长，resume 时换算回起点
+         */
+        void pause() {
+            if (mStats) {
+                mBegin = now() - mBegin;
+            }
+        }
+
+        void resume() {
+            if (mStats) {
+                mBegin = now() - mBegin;
+            }
+        }
+    };
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, 3>           outcomes{}; // 按 ListenerOutcome 下标
+        std::atomic<uint64_t>                          totalTicks{0};
+        std::atomic<uint64_t>                          maxTicks{0};
+        std::array<std::atomic<uint64_t>, BucketCount> buckets{};
+    };
+
+    std::string                     mName;
+    std::array<Shard, ShardCount>   mShards;
+    inline static std::atomic<bool> mEnabled{false};
+
+    static size_t   _shardIndex();
+    static uint32_t _bucketIndex(uint64_t ticks);
+    static uint64_t _bucketValue(uint32_t index);
+
+public:
+    LD_DISABLE_COPY_AND_MOVE(ListenerStats);
+    explicit ListenerStats(std::string name);
+
+    [[nodiscard]] static bool isEnabled() { return mEnabled.load(std::memory_order_relaxed); }
+
+    LDAPI static void setEnabled(bool enabled);
+
+    /**
+     * @brief TSC 频率是否已完成校准(基准点在插件启用时确定，约 10ms 后可用)
+     */
+    LDNDAPI static bool isCalibrated();
+
+    /**
+     * @brief 读取 TSC (非 x86 平台回退为 steady_clock)
+     */
+    LDNDAPI static uint64_t now();
+
+    /**
+     * @brief 获取监听器统计，同名共享，地址在进程内保持不变(跨配置重载保留)
+     */
+    LDNDAPI static ListenerStats& get(std::string_view name);
+
+    /**
+     * @brief 合并所有分片，按总耗时降序返回
+     * @note 尚未完成校准时返回空，不会等待
+     */
+    LDNDAPI static std::vector<Snapshot> collect();
+
+    LDAPI static void reset();
+
+    /**
+     * @brief 导出统计到数据目录下的 JSON 文件
+     * @return 导出文件路径
+     */
+    LDNDAPI static ll::Expected<std::filesystem::path> dump();
+
+    LDAPI void record(ListenerOutcome outcome, uint64_t ticks);
+
+    /**
+     * @param ratio 每纳秒的 TSC 周期数
+     */
+    LDNDAPI Snapshot snapshot(double ratio) const;
+};
+
+
+/**
+ * @brief 包装事件回调，统计开启时记录耗时与结果，并按采样率记录 EventTrace
+ * 回调返回 ListenerOutcome 时直接采用(此类回调自行记录 EventTrace)；否则按事件是否被取消判定为 Cancel/Pass
+ */
+template <typename E, typename F>
+[[nodiscard]] auto instrument(std::string_view name, F fn) {
+    auto&      stats   = ListenerStats::get(name);
+    auto const eventId = EventTrace::intern(name);
+    return [fn = std::move(fn), &stats, eventId](E& ev) {
+        constexpr bool selfTraced = std::is_same_v<std::invoke_result_t<F const&, E&>, ListenerOutcome>;
+
+        bool const timed  = ListenerStats::isEnabled();
+        bool const traced = !selfTraced && EventTrace::shouldSample();
+        if (!timed && !traced) {
+            fn(ev);
+            return;
+        }
+
+        auto            begin = timed ? ListenerStats::now() : 0;
+        ListenerOutcome outcome{ListenerOutcome::Pass};
+        if constexpr (selfTraced) {
+            outcome = fn(ev);
+        } else {
+            fn(ev);
+            if constexpr (requires { ev.isCancelled(); }) {
+                outcome = ev.isCancelled() ? ListenerOutcome::Cancel : ListenerOutcome::Pass;
+            }
+        }
+        if (timed) {
+            stats.record(outcome, ListenerStats::now() - begin);
+        }
+        if (traced) {
+            traceEvent(eventId, outcome, ev);
+        }
+    };
+}
+
+/**
+ * @brief 注册带统计的事件监听器，统计名为事件类型名
+ */
+template <typename E, typename F>
+[[nodiscard]] ll::event::ListenerPtr instrumentedListener(F fn) {
+    auto callback = instrument<E>(ll::event::getEventId<E>.name, std::move(fn));
+    return ll::event::EventBus::getInstance().emplaceListener<E>(std::move(callback));
+}
+
+
+} // namespace land
@@ -0,0 +1,141 @@
+#pragma once
+#include "pland/Global.h"
+#include "pland/PLand.h"
+#include "pland/hooks/ListenerStats.h"
+#include "pland/hooks/listeners/ListenerHelper.h"
+#include "pland/land/LandRegistry.h"
+
+#include "ll/api/event/EventId.h"
+#include "ll/api/event/ListenerBase.h"
+#include "ll/api/io/LogLevel.h"
+#include "ll/api/io/Logger.h"
+
+#include "mc/platform/UUID.h"
+#include "mc/world/level/BlockPos.h"
+
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#ifdef DISABLE_EVENT_TRACE
+#define RULE_TRACE(STATUS, MESSAGE, ...) (void(0))
+#else
+#define RULE_TRACE(STATUS, MESSAGE, ...)                                                                               \
+    do {                                                                                                               \
+        if (logger.shouldLog(ll::io::LogLevel::Trace)) {                                                               \
+            logger.trace("[rule|{}|" STATUS "] " MESSAGE, __VA_ARGS__);                                                \
+        }                                                                                                              \
+    } while (0)
+#endif
+
+namespace land {
+
+
+/**
+ * @brief 规则检查的位置
+ */
+struct RuleTarget {
+    BlockPos  pos;
+    LandDimid dimid;
+};
+
+/**
+ * @brief 声明式保护规则
+ * @tparam Locate   (E&) -> std::optional<RuleTarget>，返回空表示跳过
+ * @tparam Identify (E&) -> std::optional<mce::UUID>，返回空表示没有玩家身份(不做主人/成员/管理员豁免)
+ * @tparam Check    bool LandPermTable::* 或 (E&, LandPermTable const&) -> bool，返回 true 表示放行
+ */
+template <typename E, typename Locate, typename Identify, typename Check>
+struct ProtectionRule {
+    std::string_view name;
+    Locate           locate;
+    Identify         identify;
+    Check            check;
+};
+
+template <typename E, typename Locate, typename Identify, typename Check>
+[[nodiscard]] auto makeRule(std::string_view name, Locate locate, Identify identify, Check check) {
+    return ProtectionRule<E, Locate, Identify, Check>{name, std::move(locate), std::move(identify), std::move(check)};
+}
+
+namespace rule_identity {
+
+// 无玩家身份(环境事件)
+inline constexpr auto None = [](auto&) -> std::optional<mce::UUID> { return std::nullopt; };
+
+// 事件主体为玩家
+inline constexpr auto Self = [](auto& ev) -> std::optional<mce::UUID> { return ev.self().getUuid(); };
+
+} // namespace rule_identity
+
+
+/**
+ * @brief 将规则编译为事件回调
+ *
+ * 统一的快速路径：定位 -> 查询领地 -> 身份豁免 -> 权限位/谓词 -> 取消事件
+ * 回调返回检查结果，供 ListenerStats 统计；命中采样时记录完整的 EventTrace(位置、维度、领地、结果)
+ */
+template <typename E, typename Locate, typename Identify, typename Check>
+[[nodiscard]] auto
+compileRule(ProtectionRule<E, Locate, Identify, Check> rule, LandRegistry& db, ll::io::Logger& logger) {
+    auto const eventId = EventTrace::intern(ll::event::getEventId<E>.name);
+    return [rule = std::move(rule), &db, &logger, eventId](E& ev) -> ListenerOutcome {
+        bool const traced = EventTrace::shouldSample();
+
+        auto target = rule.locate(ev);
+        if (!target) {
+            RULE_TRACE("SKIP", "no target", rule.name);
+            if (traced) {
+                EventTrace::record(eventId, ListenerOutcome::Skip, EventTrace::NoDimid, nullptr, EventTrace::NoLand);
+            }
+            return ListenerOutcome::Skip;
+        }
+
+        auto land = db.getLandAt(target->pos, target->dimid);
+        auto done = [&](ListenerOutcome outcome) {
+            if (traced) {
+                auto id = land ? land->getId() : EventTrace::NoLand;
+                EventTrace::record(eventId, outcome, target->dimid, &target->pos, id);
+            }
+            return outcome;
+        };
+        if (!land) {
+            RULE_TRACE("PASS", "land not found, pos={}", rule.name, target->pos.toString());
+            return done(ListenerOutcome::Skip);
+        }
+
+        if (auto uuid = rule.identify(ev); uuid && PreCheckLandExistsAndPermission(land, *uuid)) {
+            RULE_TRACE("PASS", "permission allowed, land={}", rule.name, land->getId());
+            return done(ListenerOutcome::Pass);
+        }
+
+        auto const& tab = land->getPermTable();
+        bool        allow;
+        if constexpr (std::is_member_object_pointer_v<Check>) {
+            allow = tab.*(rule.check);
+        } else {
+            allow = rule.check(ev, tab);
+        }
+        if (allow) {
+            RULE_TRACE("PASS", "allowed by land={}", rule.name, land->getId());
+            return done(ListenerOutcome::Pass);
+        }
+
+        ev.cancel();
+        RULE_TRACE("CANCEL", "denied by land={}", rule.name, land->getId());
+        return done(ListenerOutcome::Cancel);
+    };
+}
+
+/**
+ * @brief 编译规则并注册到事件总线(带 ListenerStats 统计)
+ */
+template <typename E, typename Locate, typename Identify, typename Check>
+ll::event::ListenerPtr emplaceRule(ProtectionRule<E, Locate, Identify, Check> rule) {
+    auto& mod = PLand::getInstance();
+    return instrumentedListener<E>(compileRule(std::move(rule), mod.getLandRegistry(), mod.getSelf().getLogger()));
+}
+
+
+} // namespace land
@@ -1,7 +1,9 @@
 #include "pland/PLand.h"
 #include "pland/hooks/EventListener.h"
+#include "pland/hooks/ProtectionRule.h"
 #include "pland/hooks/listeners/ListenerHelper.h"
 #include "pland/hooks/optimize/HashedTypeName.h"
+#include "pland/hooks/optimize/MobDamageTable.h"
 #include "pland/infra/Config.h"
 #include "pland/land/LandRegistry.h"
 
@@ -21,152 +23,73 @@
 #include "mc/server/ServerPlayer.h"
 #include "mc/world/actor/ActorDefinitionIdentifier.h"
 
+#include <optional>
+
 
 namespace land {
 
 void EventListener::registerILAEntityListeners() {
     auto* db     = &PLand::getInstance().getLandRegistry();
-    auto* bus    = &ll::event::EventBus::getInstance();
     auto* logger = &land::PLand::getInstance().getSelf().getLogger();
 
     RegisterListenerIf(Config::cfg.listeners.ActorDestroyBlockEvent, [&]() {
-        return bus->emplaceListener<ila::mc::ActorDestroyBlockEvent>([db, logger](ila::mc::ActorDestroyBlockEvent& ev) {
-            auto& actor    = ev.self();
-            auto& blockPos = ev.pos();
-
-            EVENT_TRACE(
-                "ActorDestroyBlockEvent",
-                EVENT_TRACE_LOG,
-                "actor={}, pos={}",
-                actor.getTypeName(),
-                blockPos.toString()
-            );
-
-            auto land = db->getLandAt(blockPos, actor.getDimensionId());
-            if (PreCheckLandExistsAndPermission(land)) {
-                EVENT_TRACE("ActorDestroyBlockEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                return;
-            }
-
-            if (land->getPermTable().allowActorDestroy) {
-                EVENT_TRACE("ActorDestroyBlockEvent", EVENT_TRACE_PASS, "allowActorDestroy allowed");
-                return;
-            }
-
-            ev.cancel();
-            EVENT_TRACE("ActorDestroyBlockEvent", EVENT_TRACE_CANCEL, "permission denied");
-        });
+        return emplaceRule(makeRule<ila::mc::ActorDestroyBlockEvent>(
+            "ActorDestroyBlockEvent",
+            [](ila::mc::ActorDestroyBlockEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.self().getDimensionId()}};
+            },
+            rule_identity::None,
+            &LandPermTable::allowActorDestroy
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.MobTakeBlockBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::MobTakeBlockBeforeEvent>([db,
-                                                                       logger](ila::mc::MobTakeBlockBeforeEvent& ev) {
-            auto& actor    = ev.self();
-            auto& blockPos = ev.pos();
-
-            EVENT_TRACE(
-                "MobTakeBlockBeforeEvent",
-                EVENT_TRACE_LOG,
-                "actor={}, pos={}",
-                actor.getTypeName(),
-                blockPos.toString()
-            );
-
-            auto land = db->getLandAt(blockPos, actor.getDimensionId());
-            if (PreCheckLandExistsAndPermission(land)) {
-                EVENT_TRACE("MobTakeBlockBeforeEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                return;
-            }
-
-            if (land->getPermTable().allowActorDestroy) {
-                EVENT_TRACE("MobTakeBlockBeforeEvent", EVENT_TRACE_PASS, "allowActorDestroy allowed");
-                return;
-            }
-
-            ev.cancel();
-            EVENT_TRACE("MobTakeBlockBeforeEvent", EVENT_TRACE_CANCEL, "permission denied");
-        });
+        return emplaceRule(makeRule<ila::mc::MobTakeBlockBeforeEvent>(
+            "MobTakeBlockBeforeEvent",
+            [](ila::mc::MobTakeBlockBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.self().getDimensionId()}};
+            },
+            rule_identity::None,
+            &LandPermTable::allowActorDestroy
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.MobPlaceBlockBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::MobPlaceBlockBeforeEvent>([db,
-                                                                        logger](ila::mc::MobPlaceBlockBeforeEvent& ev) {
-            auto& actor    = ev.self();
-            auto& blockPos = ev.pos();
-
-            EVENT_TRACE(
-                "MobPlaceBlockBeforeEvent",
-                EVENT_TRACE_LOG,
-                "actor={}, pos={}",
-                actor.getTypeName(),
-                blockPos.toString()
-            );
-
-            auto land = db->getLandAt(blockPos, actor.getDimensionId());
-            if (PreCheckLandExistsAndPermission(land)) {
-                EVENT_TRACE("MobPlaceBlockBeforeEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                return;
-            }
-
-            if (land->getPermTable().allowActorDestroy) {
-                EVENT_TRACE("MobPlaceBlockBeforeEvent", EVENT_TRACE_PASS, "allowActorDestroy allowed");
-                return;
-            }
-
-            ev.cancel();
-            EVENT_TRACE("MobPlaceBlockBeforeEvent", EVENT_TRACE_CANCEL, "permission denied");
-        });
+        return emplaceRule(makeRule<ila::mc::MobPlaceBlockBeforeEvent>(
+            "MobPlaceBlockBeforeEvent",
+            [](ila::mc::MobPlaceBlockBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.self().getDimensionId()}};
+            },
+            rule_identity::None,
+            &LandPermTable::allowActorDestroy
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.ActorRideBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::ActorRideBeforeEvent>([db, logger](ila::mc::ActorRideBeforeEvent& ev) {
-            Actor& passenger = ev.self();
-            Actor& target    = ev.target();
-
-            if (!passenger.isPlayer()) {
-                EVENT_TRACE("ActorRideEvent", EVENT_TRACE_SKIP, "passenger is not player");
-                return;
-            }
-
-            EVENT_TRACE(
-                "ActorRideEvent",
-                EVENT_TRACE_LOG,
-                "passenger: {}, target: {}",
-                passenger.getActorIdentifier().mIdentifier.get(),
-                target.getTypeName()
-            );
-
-            auto& player = static_cast<Player&>(passenger);
-            auto  land   = db->getLandAt(target.getPosition(), target.getDimensionId());
-            if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                EVENT_TRACE("ActorRideEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                return;
-            }
-
-            auto& typeName       = target.getTypeName();
-            auto  hashedTypeName = HashedStringView{typeName};
-
-            auto& tab = land->getPermTable();
-            if (hashedTypeName == HashedTypeName::Minecart || hashedTypeName == HashedTypeName::Boat
-                || hashedTypeName == HashedTypeName::ChestBoat) {
-                if (tab.allowRideTrans) {
-                    EVENT_TRACE("ActorRideEvent", EVENT_TRACE_PASS, "allowRideTrans allowed");
-                    return;
+        return emplaceRule(makeRule<ila::mc::ActorRideBeforeEvent>(
+            "ActorRideEvent",
+            [](ila::mc::ActorRideBeforeEvent& ev) -> std::optional<RuleTarget> {
+                if (!ev.self().isPlayer()) {
+                    return std::nullopt; // passenger is not player
                 }
-            } else {
-                if (tab.allowRideEntity) {
-                    EVENT_TRACE("ActorRideEvent", EVENT_TRACE_PASS, "allowRideEntity allowed");
-                    return;
+                return RuleTarget{ev.target().getPosition(), ev.target().getDimensionId()};
+            },
+            [](ila::mc::ActorRideBeforeEvent& ev) -> std::optional<mce::UUID> {
+                return static_cast<Player&>(ev.self()).getUuid();
+            },
+            [](ila::mc::ActorRideBeforeEvent& ev, LandPermTable const& tab) {
+                auto hashedTypeName = HashedStringView{ev.target().getTypeName()};
+                if (hashedTypeName == HashedTypeName::Minecart || hashedTypeName == HashedTypeName::Boat
+                    || hashedTypeName == HashedTypeName::ChestBoat) {
+                    return tab.allowRideTrans;
                 }
+                return tab.allowRideEntity;
             }
-
-            ev.cancel();
-            EVENT_TRACE("ActorRideEvent", EVENT_TRACE_CANCEL, "permission denied");
-        });
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.MobHurtEffectBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::MobHurtEffectBeforeEvent>([db,
+        return instrumentedListener<ila::mc::MobHurtEffectBeforeEvent>([db,
                                                                         logger](ila::mc::MobHurtEffectBeforeEvent& ev) {
             auto& actor = ev.self();
 
@@ -184,101 +107,57 @@ void EventListener::registerILAEntityListeners() {
                 return;
             }
 
-            auto const& typeName = actor.getTypeName();
-            auto const& tab      = land->getPermTable();
+            auto const& tab = land->getPermTable();
 
-            if (actor.isPlayer()) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowPlayerDamage,
-                    EVENT_TRACE("MobHurtEffectEvent", EVENT_TRACE_CANCEL, "allowPlayerDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.hostileMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowMonsterDamage,
-                    EVENT_TRACE("MobHurtEffectEvent", EVENT_TRACE_CANCEL, "allowMonsterDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.specialMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowSpecialDamage,
-                    EVENT_TRACE("MobHurtEffectEvent", EVENT_TRACE_CANCEL, "allowSpecialDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.passiveMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowPassiveDamage,
-                    EVENT_TRACE("MobHurtEffectEvent", EVENT_TRACE_CANCEL, "allowPassiveDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.customSpecialMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowCustomSpecialDamage,
-                    EVENT_TRACE("MobHurtEffectEvent", EVENT_TRACE_CANCEL, "allowCustomSpecialDamage denied")
-                );
+            if (auto perm = MobDamageTable::lookup(actor); perm && !(tab.*(perm->ptr))) {
+                EVENT_TRACE("MobHurtEffectEvent", EVENT_TRACE_CANCEL, "{} denied", perm->name);
+                ev.cancel();
+                return;
             }
         });
     });
 
     RegisterListenerIf(Config::cfg.listeners.ActorTriggerPressurePlateBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::ActorTriggerPressurePlateBeforeEvent>(
-            [db, logger](ila::mc::ActorTriggerPressurePlateBeforeEvent& ev) {
-                EVENT_TRACE("ActorTriggerPressurePlateEvent", EVENT_TRACE_LOG, "pos={}", ev.pos().toString());
-
+        return emplaceRule(makeRule<ila::mc::ActorTriggerPressurePlateBeforeEvent>(
+            "ActorTriggerPressurePlateEvent",
+            [](ila::mc::ActorTriggerPressurePlateBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.self().getDimensionId()}};
+            },
+            [](ila::mc::ActorTriggerPressurePlateBeforeEvent& ev) -> std::optional<mce::UUID> {
                 auto& actor = ev.self();
-                auto& uuid  = actor.isPlayer() ? static_cast<Player&>(actor).getUuid() : mce::UUID::EMPTY();
-
-                auto land = db->getLandAt(ev.pos(), ev.self().getDimensionId());
-                if (PreCheckLandExistsAndPermission(land, uuid)) {
-                    EVENT_TRACE(
-                        "ActorTriggerPressurePlateEvent",
-                        EVENT_TRACE_PASS,
-                        "land not found or permission allowed"
-                    );
-                    return;
-                }
-
-                if (land->getPermTable().usePressurePlate) {
-                    EVENT_TRACE("ActorTriggerPressurePlateEvent", EVENT_TRACE_PASS, "usePressurePlate allowed");
-                    return;
+                if (!actor.isPlayer()) {
+                    return std::nullopt;
                 }
-
-                ev.cancel();
-                EVENT_TRACE("ActorTriggerPressurePlateEvent", EVENT_TRACE_CANCEL, "permission denied");
-            }
-        );
+                return static_cast<Player&>(actor).getUuid();
+            },
+            &LandPermTable::usePressurePlate
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.ProjectileCreateBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::ProjectileCreateBeforeEvent>(
-            [db, logger](ila::mc::ProjectileCreateBeforeEvent& ev) {
-                auto& projectile = ev.self(); // projectile
-                auto  owner      = projectile.getOwner();
-                if (!owner) {
-                    EVENT_TRACE("ProjectileCreateEvent", EVENT_TRACE_SKIP, "projectile has no owner");
-                    return;
+        return emplaceRule(makeRule<ila::mc::ProjectileCreateBeforeEvent>(
+            "ProjectileCreateEvent",
+            [](ila::mc::ProjectileCreateBeforeEvent& ev) -> std::optional<RuleTarget> {
+                auto& projectile = ev.self();
+                if (!projectile.getOwner()) {
+                    return std::nullopt; // projectile has no owner
                 }
-
-                auto& typeName = projectile.getTypeName();
-                EVENT_TRACE("ProjectileCreateEvent", EVENT_TRACE_LOG, "type={}", typeName);
-
-                auto& uuid = owner->isPlayer() ? static_cast<Player&>(*owner).getUuid() : mce::UUID::EMPTY();
-                auto  land = db->getLandAt(projectile.getPosition(), projectile.getDimensionId());
-                if (PreCheckLandExistsAndPermission(land, uuid)) {
-                    EVENT_TRACE("ProjectileCreateEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                    return;
+                return RuleTarget{projectile.getPosition(), projectile.getDimensionId()};
+            },
+            [](ila::mc::ProjectileCreateBeforeEvent& ev) -> std::optional<mce::UUID> {
+                auto owner = ev.self().getOwner();
+                if (!owner || !owner->isPlayer()) {
+                    return std::nullopt;
                 }
-
-                auto const& tab = land->getPermTable();
-                if (HashedStringView{typeName} == HashedTypeName::FishingHook) {
-                    CANCEL_AND_RETURN_IF(
-                        !tab.allowFishingRodAndHook,
-                        EVENT_TRACE("ProjectileCreateEvent", EVENT_TRACE_CANCEL, "allowFishingRodAndHook denied")
-                    );
-                } else {
-                    CANCEL_AND_RETURN_IF(
-                        !tab.allowProjectileCreate,
-                        EVENT_TRACE("ProjectileCreateEvent", EVENT_TRACE_CANCEL, "allowProjectileCreate denied")
-                    )
+                return static_cast<Player&>(*owner).getUuid();
+            },
+            [](ila::mc::ProjectileCreateBeforeEvent& ev, LandPermTable const& tab) {
+                if (HashedStringView{ev.self().getTypeName()} == HashedTypeName::FishingHook) {
+                    return tab.allowFishingRodAndHook;
                 }
+                return tab.allowProjectileCreate;
             }
-        );
+        ));
     });
 }
 
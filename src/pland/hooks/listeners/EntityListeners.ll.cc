@@ -1,4 +1,5 @@
 #include "pland/hooks/EventListener.h"
+#include "pland/hooks/ListenerStats.h"
 #include "pland/hooks/listeners/ListenerHelper.h"
 
 #include "ll/api/event/EventBus.h"
@@ -10,6 +11,7 @@
 #include "mc/world/level/Level.h"
 
 #include "pland/PLand.h"
+#include "pland/hooks/optimize/MobDamageTable.h"
 #include "pland/infra/Config.h"
 #include "pland/land/LandRegistry.h"
 
@@ -18,11 +20,10 @@ namespace land {
 
 void EventListener::registerLLEntityListeners() {
     auto* db     = &PLand::getInstance().getLandRegistry();
-    auto* bus    = &ll::event::EventBus::getInstance();
     auto* logger = &land::PLand::getInstance().getSelf().getLogger();
 
     RegisterListenerIf(Config::cfg.listeners.SpawnedMobEvent, [&]() {
-        return bus->emplaceListener<ll::event::SpawnedMobEvent>([db, logger](ll::event::SpawnedMobEvent& ev) {
+        return instrumentedListener<ll::event::SpawnedMobEvent>([db, logger](ll::event::SpawnedMobEvent& ev) {
             auto mob = ev.mob();
             if (!mob.has_value()) {
                 EVENT_TRACE("SpawnedMobEvent", EVENT_TRACE_SKIP, "mob not found");
@@ -47,7 +48,7 @@ void EventListener::registerLLEntityListeners() {
     });
 
     RegisterListenerIf(Config::cfg.listeners.ActorHurtEvent, [&]() {
-        return bus->emplaceListener<ll::event::ActorHurtEvent>([db, logger](ll::event::ActorHurtEvent& ev) {
+        return instrumentedListener<ll::event::ActorHurtEvent>([db, logger](ll::event::ActorHurtEvent& ev) {
             auto& actor  = ev.self();
             auto& source = ev.source();
 
@@ -68,34 +69,12 @@ void EventListener::registerLLEntityListeners() {
                 return;
             }
 
-            auto const& typeName = actor.getTypeName();
-            auto const& tab      = land->getPermTable();
-
-            if (actor.isPlayer()) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowPlayerDamage,
-                    EVENT_TRACE("ActorHurtEvent", EVENT_TRACE_CANCEL, "allowPlayerDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.hostileMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowMonsterDamage,
-                    EVENT_TRACE("ActorHurtEvent", EVENT_TRACE_CANCEL, "allowMonsterDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.specialMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowSpecialDamage,
-                    EVENT_TRACE("ActorHurtEvent", EVENT_TRACE_CANCEL, "allowSpecialDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.passiveMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowPassiveDamage,
-                    EVENT_TRACE("ActorHurtEvent", EVENT_TRACE_CANCEL, "allowPassiveDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.customSpecialMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowCustomSpecialDamage,
-                    EVENT_TRACE("ActorHurtEvent", EVENT_TRACE_CANCEL, "allowCustomSpecialDamage denied")
-                );
+            auto const& tab = land->getPermTable();
+
+            if (auto perm = MobDamageTable::lookup(actor); perm && !(tab.*(perm->ptr))) {
+                EVENT_TRACE("ActorHurtEvent", EVENT_TRACE_CANCEL, "{} denied", perm->name);
+                ev.cancel();
+                return;
             }
         });
     });
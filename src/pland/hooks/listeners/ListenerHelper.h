@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include "ll/api/io/LogLevel.h"
+
 #include "mc/platform/UUID.h"
 #include "mc/world/level/block/BlockProperty.h"
 
@@ -43,8 +45,13 @@
     #define EVENT_TRACE_CANCEL "CANCEL" // 事件被取消
     #define EVENT_TRACE_LOG "LOG" // 事件信息
 
+    // 先检查日志等级，未开启 Trace 时不格式化参数
     #define EVENT_TRACE(NAME, STATUS, MESSAGE, ...)                                                                             \
-        logger->trace("[{}:" STR(__LINE__) "|" NAME "|" STATUS "] " MESSAGE, relative_file(__FILE__), __VA_ARGS__)
+        do {                                                                                                                    \
+            if (logger->shouldLog(ll::io::LogLevel::Trace)) {                                                                   \
+                logger->trace("[{}:" STR(__LINE__) "|" NAME "|" STATUS "] " MESSAGE, relative_file(__FILE__), __VA_ARGS__);    \
+            }                                                                                                                   \
+        } while (0)
 #endif
 // clang-format on
 
@@ -1,6 +1,7 @@
 
 #include "pland/PLand.h"
 #include "pland/hooks/EventListener.h"
+#include "pland/hooks/ProtectionRule.h"
 #include "pland/hooks/listeners/ListenerHelper.h"
 #include "pland/infra/Config.h"
 #include "pland/land/LandRegistry.h"
@@ -18,179 +19,81 @@
 #include "mc/world/level/block/Block.h"
 #include "pland/hooks/optimize/HashedTypeName.h"
 
+#include <optional>
+
 
 namespace land {
 
 void EventListener::registerILAPlayerListeners() {
-    auto* db     = &PLand::getInstance().getLandRegistry();
-    auto* bus    = &ll::event::EventBus::getInstance();
-    auto* logger = &land::PLand::getInstance().getSelf().getLogger();
-
     RegisterListenerIf(Config::cfg.listeners.PlayerInteractEntityBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::PlayerInteractEntityBeforeEvent>(
-            [db, logger](ila::mc::PlayerInteractEntityBeforeEvent& ev) {
-                auto& player = ev.self();
-                auto& target = ev.target();
-
-                EVENT_TRACE(
-                    "PlayerInteractEntityEvent",
-                    EVENT_TRACE_LOG,
-                    "player={}, target={}",
-                    player.getRealName(),
-                    target.getTypeName()
-                );
-
-                auto land = db->getLandAt(target.getPosition(), player.getDimensionId());
-                if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                    EVENT_TRACE("PlayerInteractEntityEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                    return;
-                }
-
-                if (land->getPermTable().allowInteractEntity) {
-                    EVENT_TRACE("PlayerInteractEntityEvent", EVENT_TRACE_PASS, "allowInteractEntity allowed");
-                    return;
-                }
-
-                ev.cancel();
-                EVENT_TRACE("PlayerInteractEntityEvent", EVENT_TRACE_CANCEL, "permission denied");
-            }
-        );
+        return emplaceRule(makeRule<ila::mc::PlayerInteractEntityBeforeEvent>(
+            "PlayerInteractEntityEvent",
+            [](ila::mc::PlayerInteractEntityBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.target().getPosition(), ev.self().getDimensionId()}};
+            },
+            rule_identity::Self,
+            &LandPermTable::allowInteractEntity
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.PlayerAttackBlockBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::PlayerAttackBlockBeforeEvent>([db, logger](
-                                                                               ila::mc::PlayerAttackBlockBeforeEvent& ev
-                                                                           ) {
-            auto& player = ev.self();
-            auto& pos    = ev.pos();
-
-            EVENT_TRACE(
-                "PlayerAttackBlockEvent",
-                EVENT_TRACE_LOG,
-                "player={}, pos={}",
-                player.getRealName(),
-                pos.toString()
-            );
-
-            auto land = db->getLandAt(pos, player.getDimensionId());
-            if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                EVENT_TRACE("PlayerAttackBlockEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                return;
-            }
-
-            auto const& typeName = player.getDimensionBlockSourceConst().getBlock(pos).getTypeName();
-            if (HashedStringView{typeName} == HashedTypeName::DragonEgg && !land->getPermTable().allowAttackDragonEgg) {
-                ev.cancel();
-                EVENT_TRACE("PlayerAttackBlockEvent", EVENT_TRACE_CANCEL, "allowAttackDragonEgg denied");
+        return emplaceRule(makeRule<ila::mc::PlayerAttackBlockBeforeEvent>(
+            "PlayerAttackBlockEvent",
+            [](ila::mc::PlayerAttackBlockBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.self().getDimensionId()}};
+            },
+            rule_identity::Self,
+            [](ila::mc::PlayerAttackBlockBeforeEvent& ev, LandPermTable const& tab) {
+                auto const& typeName = ev.self().getDimensionBlockSourceConst().getBlock(ev.pos()).getTypeName();
+                return tab.allowAttackDragonEgg || HashedStringView{typeName} != HashedTypeName::DragonEgg;
             }
-        });
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.ArmorStandSwapItemBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::ArmorStandSwapItemBeforeEvent>(
-            [db, logger](ila::mc::ArmorStandSwapItemBeforeEvent& ev) {
-                auto& player = ev.player();
-
-                EVENT_TRACE("ArmorStandSwapItemEvent", EVENT_TRACE_LOG, "player={}", player.getRealName());
-
-                auto land = db->getLandAt(ev.self().getPosition(), player.getDimensionId());
-                if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                    EVENT_TRACE("ArmorStandSwapItemEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                    return;
-                }
-
-                if (land->getPermTable().useArmorStand) {
-                    EVENT_TRACE("ArmorStandSwapItemEvent", EVENT_TRACE_PASS, "useArmorStand allowed");
-                    return;
-                }
-
-                ev.cancel();
-                EVENT_TRACE("ArmorStandSwapItemEvent", EVENT_TRACE_CANCEL, "permission denied");
-            }
-        );
+        return emplaceRule(makeRule<ila::mc::ArmorStandSwapItemBeforeEvent>(
+            "ArmorStandSwapItemEvent",
+            [](ila::mc::ArmorStandSwapItemBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.self().getPosition(), ev.player().getDimensionId()}};
+            },
+            [](ila::mc::ArmorStandSwapItemBeforeEvent& ev) -> std::optional<mce::UUID> {
+                return ev.player().getUuid();
+            },
+            &LandPermTable::useArmorStand
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.PlayerDropItemBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::PlayerDropItemBeforeEvent>(
-            [db, logger](ila::mc::PlayerDropItemBeforeEvent& ev) {
-                auto& player = ev.self();
-
-                EVENT_TRACE("PlayerDropItemEvent", EVENT_TRACE_LOG, "player={}", player.getRealName());
-
-                auto land = db->getLandAt(player.getPosition(), player.getDimensionId());
-                if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                    EVENT_TRACE("PlayerDropItemEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                    return;
-                }
-
-                if (land->getPermTable().allowDropItem) {
-                    EVENT_TRACE("PlayerDropItemEvent", EVENT_TRACE_PASS, "allowDropItem allowed");
-                    return;
-                }
-
-                ev.cancel();
-                EVENT_TRACE("PlayerDropItemEvent", EVENT_TRACE_CANCEL, "permission denied");
-            }
-        );
+        return emplaceRule(makeRule<ila::mc::PlayerDropItemBeforeEvent>(
+            "PlayerDropItemEvent",
+            [](ila::mc::PlayerDropItemBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.self().getPosition(), ev.self().getDimensionId()}};
+            },
+            rule_identity::Self,
+            &LandPermTable::allowDropItem
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.PlayerOperatedItemFrameBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::PlayerOperatedItemFrameBeforeEvent>(
-            [db, logger](ila::mc::PlayerOperatedItemFrameBeforeEvent& ev) {
-                auto& player = ev.self();
-                auto& pos    = ev.blockPos();
-
-                EVENT_TRACE(
-                    "PlayerUseItemFrameEvent",
-                    EVENT_TRACE_LOG,
-                    "player={}, pos={}",
-                    player.getRealName(),
-                    pos.toString()
-                );
-
-                auto land = db->getLandAt(ev.blockPos(), player.getDimensionId());
-                if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                    EVENT_TRACE("PlayerUseItemFrameEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                    return;
-                }
-
-                if (land->getPermTable().useItemFrame) {
-                    EVENT_TRACE("PlayerUseItemFrameEvent", EVENT_TRACE_PASS, "useItemFrame allowed");
-                    return;
-                }
-
-                ev.cancel();
-                EVENT_TRACE("PlayerUseItemFrameEvent", EVENT_TRACE_CANCEL, "permission denied");
-            }
-        );
+        return emplaceRule(makeRule<ila::mc::PlayerOperatedItemFrameBeforeEvent>(
+            "PlayerUseItemFrameEvent",
+            [](ila::mc::PlayerOperatedItemFrameBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.blockPos(), ev.self().getDimensionId()}};
+            },
+            rule_identity::Self,
+            &LandPermTable::useItemFrame
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.PlayerEditSignBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::PlayerEditSignBeforeEvent>(
-            [db, logger](ila::mc::PlayerEditSignBeforeEvent& ev) {
-                auto& player = ev.self();
-                auto& pos    = ev.pos();
-
-                EVENT_TRACE(
-                    "PlayerEditSignEvent",
-                    EVENT_TRACE_LOG,
-                    "player={}, pos={}",
-                    player.getRealName(),
-                    pos.toString()
-                );
-
-                auto land = db->getLandAt(pos, player.getDimensionId());
-                if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                    EVENT_TRACE("PlayerEditSignEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                    return;
-                }
-
-                if (!land->getPermTable().editSign) {
-                    ev.cancel();
-                    EVENT_TRACE("PlayerEditSignEvent", EVENT_TRACE_CANCEL, "editSign denied");
-                }
-            }
-        );
+        return emplaceRule(makeRule<ila::mc::PlayerEditSignBeforeEvent>(
+            "PlayerEditSignEvent",
+            [](ila::mc::PlayerEditSignBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.self().getDimensionId()}};
+            },
+            rule_identity::Self,
+            &LandPermTable::editSign
+        ));
     });
 }
 
@@ -1,5 +1,6 @@
 
 #include "pland/hooks/EventListener.h"
+#include "pland/hooks/ProtectionRule.h"
 #include "pland/hooks/listeners/ListenerHelper.h"
 
 #include "ll/api/event/EventBus.h"
@@ -17,9 +18,11 @@
 #include "mc/world/item/HoeItem.h"
 #include "mc/world/item/HorseArmorItem.h"
 #include "mc/world/item/Item.h"
+#include "mc/world/item/ItemStack.h"
 #include "mc/world/item/ItemTag.h"
 #include "mc/world/item/ShovelItem.h"
 #include "mc/world/level/block/BlastFurnaceBlock.h"
+#include "mc/world/level/block/Block.h"
 #include "mc/world/level/block/FurnaceBlock.h"
 #include "mc/world/level/block/HangingSignBlock.h"
 #include "mc/world/level/block/ShulkerBoxBlock.h"
@@ -28,20 +31,54 @@
 
 #include "pland/PLand.h"
 #include "pland/hooks/optimize/HashedTypeName.h"
+#include "pland/hooks/optimize/MobDamageTable.h"
 #include "pland/infra/Config.h"
 #include "pland/land/LandRegistry.h"
 #include "pland/utils/McUtils.h"
 
+#include <array>
+#include <cstdint>
+#include <optional>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 
 namespace land {
 
+// 交互权限缓存: 以运行时数字 ID 为下标的稠密表，每项保存需要检查的权限位(按检查顺序，0 为无)
+// 每种物品/方块首次交互时解析一次(名称映射 + 类型判断)，之后只需数组访问；配置重载时清空
+using PermSlot = uint8_t;
+struct PermSlotInfo {
+    bool LandPermTable::* ptr;
+    std::string_view      name;
+};
+struct InteractPermEntry {
+    bool                    resolved{false};
+    std::array<PermSlot, 3> slots{};
+};
+static constexpr size_t InteractPermTableSize = 1 << 16; // 覆盖全部 16 位 ID
+
+static std::vector<PermSlotInfo>      PermSlots;      // 下标 0 保留
+static std::vector<InteractPermEntry> ItemPermTable;  // 下标: Item::getId()
+static std::vector<InteractPermEntry> BlockPermTable; // 下标: BlockType::getBlockItemId()
+
 // These maps are used by PlayerInteractBlockEvent, so they stay in this file.
-static std::unordered_map<HashedStringView, bool LandPermTable::*> ItemSpecificPermissionMap;
-static std::unordered_map<HashedStringView, bool LandPermTable::*> BlockSpecificPermissionMap;
-static std::unordered_map<HashedStringView, bool LandPermTable::*> BlockFunctionalPermissionMap;
+// They are only probed once per item/block type, the results are cached in the dense tables above.
+static std::unordered_map<HashedStringView, PermSlot> ItemSpecificPermissionMap;
+static std::unordered_map<HashedStringView, PermSlot> BlockSpecificPermissionMap;
+static std::unordered_map<HashedStringView, PermSlot> BlockFunctionalPermissionMap;
+
+static PermSlot getPermSlot(bool LandPermTable::* ptr, std::string_view name) {
+    for (size_t i = 1; i < PermSlots.size(); ++i) {
+        if (PermSlots[i].ptr == ptr) {
+            return static_cast<PermSlot>(i);
+        }
+    }
+    PermSlots.push_back({ptr, name});
+    return static_cast<PermSlot>(PermSlots.size() - 1);
+}
+
 
 // A map to convert permission names (from config) to member pointers.
 static const std::unordered_map<HashedStringView, bool LandPermTable::*> StringToPermPtrMap = {
@@ -88,6 +125,10 @@ static const std::unordered_map<HashedStringView, bool LandPermTable::*> StringT
 void loadPermissionMapsFromConfig() {
     auto logger = &land::PLand::getInstance().getSelf().getLogger();
 
+    PermSlots.assign(1, PermSlotInfo{nullptr, {}});
+    ItemPermTable.assign(InteractPermTableSize, {});
+    BlockPermTable.assign(InteractPermTableSize, {});
+
     ItemSpecificPermissionMap.clear();
     BlockSpecificPermissionMap.clear();
     BlockFunctionalPermissionMap.clear();
@@ -96,7 +137,7 @@ void loadPermissionMapsFromConfig() {
         for (const auto& [itemName, permName] : configMap) {
             auto it = StringToPermPtrMap.find(HashedStringView{permName});
             if (it != StringToPermPtrMap.end()) {
-                targetMap.emplace(itemName, it->second);
+                targetMap.emplace(itemName, getPermSlot(it->second, it->first.mStr));
             } else {
                 logger->warn(
                     "Permission '{}' for item '{}' in '{}' map not found. Ignoring.",
@@ -113,85 +154,126 @@ void loadPermissionMapsFromConfig() {
     populateMap(Config::cfg.protection.permissionMaps.blockFunctional, BlockFunctionalPermissionMap, "blockFunctional");
 }
 
+static PermSlot findPermSlot(std::unordered_map<HashedStringView, PermSlot> const& map, std::string_view typeName) {
+    if (auto iter = map.find(HashedStringView{typeName}); iter != map.end()) {
+        return iter->second;
+    }
+    return 0;
+}
+
+static InteractPermEntry const& resolveItemPermissions(ItemStack const& itemStack, Item const& item) {
+    auto& entry = ItemPermTable[static_cast<uint16_t>(item.getId())];
+    if (entry.resolved) {
+        return entry;
+    }
+    entry.resolved = true;
+
+    void** vftable = *reinterpret_cast<void** const*>(&item);
+    if (vftable == BucketItem::$vftable()) {
+        entry.slots[0] = getPermSlot(&LandPermTable::useBucket, "useBucket");
+    } else if (vftable == HatchetItem::$vftable()) {
+        entry.slots[0] = getPermSlot(&LandPermTable::allowAxePeeled, "allowAxePeeled");
+    } else if (vftable == HoeItem::$vftable()) {
+        entry.slots[0] = getPermSlot(&LandPermTable::useHoe, "useHoe");
+    } else if (vftable == ShovelItem::$vftable()) {
+        entry.slots[0] = getPermSlot(&LandPermTable::useShovel, "useShovel");
+    } else if (item.hasTag(HashedTypeName::BoatTag) || item.hasTag(HashedTypeName::BoatsTag)) {
+        entry.slots[0] = getPermSlot(&LandPermTable::placeBoat, "placeBoat");
+    } else if (item.hasTag(HashedTypeName::MinecartTag)) {
+        entry.slots[0] = getPermSlot(&LandPermTable::placeMinecart, "placeMinecart");
+    }
+    entry.slots[1] = findPermSlot(ItemSpecificPermissionMap, itemStack.getTypeName());
+    return entry;
+}
+
+static InteractPermEntry const& resolveBlockPermissions(Block const& block) {
+    auto const& legacyBlock = block.getBlockType();
+
+    auto& entry = BlockPermTable[static_cast<uint16_t>(legacyBlock.getBlockItemId())];
+    if (entry.resolved) {
+        return entry;
+    }
+    entry.resolved = true;
+
+    auto const& typeName = block.getTypeName();
+    entry.slots[0]       = findPermSlot(BlockSpecificPermissionMap, typeName);
+    entry.slots[1]       = findPermSlot(BlockFunctionalPermissionMap, typeName);
+
+    void** vftable = *reinterpret_cast<void** const*>(&legacyBlock);
+    if (legacyBlock.isButtonBlock()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::useButton, "useButton");
+    } else if (legacyBlock.isDoorBlock()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::useDoor, "useDoor");
+    } else if (legacyBlock.isFenceGateBlock()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::useFenceGate, "useFenceGate");
+    } else if (legacyBlock.isFenceBlock()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::allowInteractEntity, "allowInteractEntity");
+    } else if (legacyBlock.mIsTrapdoor) {
+        entry.slots[2] = getPermSlot(&LandPermTable::useTrapdoor, "useTrapdoor");
+    } else if (vftable == SignBlock::$vftable() || vftable == HangingSignBlock::$vftable()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::editSign, "editSign");
+    } else if (vftable == ShulkerBoxBlock::$vftable()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::useShulkerBox, "useShulkerBox");
+    } else if (legacyBlock.isCraftingBlock()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::useCraftingTable, "useCraftingTable");
+    } else if (legacyBlock.isLeverBlock()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::useLever, "useLever");
+    } else if (vftable == BlastFurnaceBlock::$vftable()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::useBlastFurnace, "useBlastFurnace");
+    } else if (vftable == FurnaceBlock::$vftable()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::useFurnace, "useFurnace");
+    } else if (vftable == SmokerBlock::$vftable()) {
+        entry.slots[2] = getPermSlot(&LandPermTable::useSmoker, "useSmoker");
+    }
+    return entry;
+}
+
+// 返回第一个被拒绝的权限，全部放行时返回 nullptr
+static PermSlotInfo const* findDeniedPermission(InteractPermEntry const& entry, LandPermTable const& tab) {
+    for (auto slot : entry.slots) {
+        if (slot != 0 && !(tab.*(PermSlots[slot].ptr))) {
+            return &PermSlots[slot];
+        }
+    }
+    return nullptr;
+}
+
 
 void EventListener::registerLLPlayerListeners() {
     loadPermissionMapsFromConfig();
     auto* db     = &PLand::getInstance().getLandRegistry();
-    auto* bus    = &ll::event::EventBus::getInstance();
     auto* logger = &land::PLand::getInstance().getSelf().getLogger();
 
     RegisterListenerIf(Config::cfg.listeners.PlayerDestroyBlockEvent, [&]() {
-        return bus->emplaceListener<ll::event::PlayerDestroyBlockEvent>(
-            [db, logger](ll::event::PlayerDestroyBlockEvent& ev) {
-                auto& player   = ev.self();
-                auto& blockPos = ev.pos();
-
-                EVENT_TRACE(
-                    "PlayerDestroyBlockEvent",
-                    EVENT_TRACE_LOG,
-                    "player={}, pos={}",
-                    player.getRealName(),
-                    blockPos.toString()
-                );
-
-                auto land = db->getLandAt(blockPos, player.getDimensionId());
-                if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                    EVENT_TRACE("PlayerDestroyBlockEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                    return;
-                }
-
-                auto& tab = land->getPermTable();
-                if (tab.allowDestroy) {
-                    EVENT_TRACE("PlayerDestroyBlockEvent", EVENT_TRACE_PASS, "allowDestroy allowed");
-                    return;
-                }
-
-                ev.cancel();
-                EVENT_TRACE("PlayerDestroyBlockEvent", EVENT_TRACE_CANCEL, "allowDestroy denied");
-            }
-        );
+        return emplaceRule(makeRule<ll::event::PlayerDestroyBlockEvent>(
+            "PlayerDestroyBlockEvent",
+            [](ll::event::PlayerDestroyBlockEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.self().getDimensionId()}};
+            },
+            rule_identity::Self,
+            &LandPermTable::allowDestroy
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.PlayerPlacingBlockEvent, [&]() {
-        return bus->emplaceListener<ll::event::PlayerPlacingBlockEvent>(
-            [db, logger](ll::event::PlayerPlacingBlockEvent& ev) {
-                auto& player   = ev.self();
-                auto  blockPos = mc_utils::face2Pos(ev.pos(), ev.face());
-
-                EVENT_TRACE(
-                    "PlayerPlacingBlockEvent",
-                    EVENT_TRACE_LOG,
-                    "player={}, pos={}",
-                    player.getRealName(),
-                    blockPos.toString()
-                );
-
-                auto land = db->getLandAt(blockPos, player.getDimensionId());
-                if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                    EVENT_TRACE("PlayerPlacingBlockEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                    return;
-                }
-
-                auto& tab = land->getPermTable();
-                if (tab.allowPlace) {
-                    EVENT_TRACE("PlayerPlacingBlockEvent", EVENT_TRACE_PASS, "allowPlace allowed");
-                    return;
-                }
-
-                ev.cancel();
-                EVENT_TRACE("PlayerPlacingBlockEvent", EVENT_TRACE_CANCEL, "allowPlace denied");
-            }
-        );
+        return emplaceRule(makeRule<ll::event::PlayerPlacingBlockEvent>(
+            "PlayerPlacingBlockEvent",
+            [](ll::event::PlayerPlacingBlockEvent& ev) {
+                return std::optional<RuleTarget>{
+                    {mc_utils::face2Pos(ev.pos(), ev.face()), ev.self().getDimensionId()}
+                };
+            },
+            rule_identity::Self,
+            &LandPermTable::allowPlace
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.PlayerInteractBlockEvent, [&]() {
-        return bus->emplaceListener<ll::event::PlayerInteractBlockEvent>(
+        return instrumentedListener<ll::event::PlayerInteractBlockEvent>(
             [db, logger](ll::event::PlayerInteractBlockEvent& ev) {
-                auto&      player         = ev.self();
-                auto&      pos            = ev.blockPos();
-                auto&      itemStack      = ev.item();
-                auto const itemTypeName   = itemStack.getTypeName();
-                auto       hashedItemType = HashedStringView{itemTypeName};
+                auto& player    = ev.self();
+                auto& pos       = ev.blockPos();
+                auto& itemStack = ev.item();
 
                 EVENT_TRACE(
                     "PlayerInteractBlockEvent",
@@ -199,7 +281,7 @@ void EventListener::registerLLPlayerListeners() {
                     "player={}, pos={}, item={}",
                     player.getRealName(),
                     pos.toString(),
-                    itemTypeName
+                    itemStack.getTypeName()
                 );
 
                 auto land = db->getLandAt(pos, player.getDimensionId());
@@ -211,151 +293,40 @@ void EventListener::registerLLPlayerListeners() {
                 auto const& tab = land->getPermTable();
 
                 if (auto item = itemStack.getItem()) {
-                    void** vftable = *reinterpret_cast<void** const*>(item);
-                    if (vftable == BucketItem::$vftable()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useBucket,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useBucket denied")
-                        );
-                    } else if (vftable == HatchetItem::$vftable()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.allowAxePeeled,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "allowAxePeeled denied")
-                        );
-                    } else if (vftable == HoeItem::$vftable()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useHoe,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useHoe denied")
-                        );
-                    } else if (vftable == ShovelItem::$vftable()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useShovel,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useShovel denied")
-                        );
-                    } else if (item->hasTag(HashedTypeName::BoatTag) || item->hasTag(HashedTypeName::BoatsTag)) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.placeBoat,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "placeBoat denied")
-                        );
-                    } else if (item->hasTag(HashedTypeName::MinecartTag)) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.placeMinecart,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "placeMinecart denied")
-                        );
-                    }
-                }
-                if (auto it = ItemSpecificPermissionMap.find(hashedItemType);
-                    it != ItemSpecificPermissionMap.end() && !(tab.*(it->second))) {
-                    EVENT_TRACE(
-                        "PlayerInteractBlockEvent",
-                        EVENT_TRACE_CANCEL,
-                        "Item check: '{}', specific permission is false.",
-                        itemTypeName
-                    );
-                    ev.cancel();
-                    return;
-                }
-
-
-                if (auto block = ev.block()) {
-                    auto const& typeName    = block->getTypeName();
-                    auto const& legacyBlock = block->getBlockType();
-
-                    auto hashedBlockTy = HashedStringView{typeName};
-
-                    if (auto iter = BlockSpecificPermissionMap.find(hashedBlockTy);
-                        iter != BlockSpecificPermissionMap.end() && !(tab.*(iter->second))) {
+                    auto const& entry = resolveItemPermissions(itemStack, *item);
+                    if (auto denied = findDeniedPermission(entry, tab)) {
                         EVENT_TRACE(
                             "PlayerInteractBlockEvent",
                             EVENT_TRACE_CANCEL,
-                            "Block check: '{}', specific permission is false.",
-                            typeName
+                            "Item check: '{}', {} denied",
+                            itemStack.getTypeName(),
+                            denied->name
                         );
                         ev.cancel();
                         return;
                     }
+                }
 
-                    if (auto iter = BlockFunctionalPermissionMap.find(hashedBlockTy);
-                        iter != BlockFunctionalPermissionMap.end() && !(tab.*(iter->second))) {
+                if (auto block = ev.block()) {
+                    auto const& entry = resolveBlockPermissions(*block);
+                    if (auto denied = findDeniedPermission(entry, tab)) {
                         EVENT_TRACE(
                             "PlayerInteractBlockEvent",
                             EVENT_TRACE_CANCEL,
-                            "Block check: '{}', functional permission is false.",
-                            typeName
+                            "Block check: '{}', {} denied",
+                            block->getTypeName(),
+                            denied->name
                         );
                         ev.cancel();
                         return;
                     }
-
-                    void** vftable = *reinterpret_cast<void** const*>(&legacyBlock);
-                    if (legacyBlock.isButtonBlock()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useButton,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useButton denied")
-                        );
-                    } else if (legacyBlock.isDoorBlock()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useDoor,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useDoor denied")
-                        );
-                    } else if (legacyBlock.isFenceGateBlock()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useFenceGate,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useFenceGate denied")
-                        );
-                    } else if (legacyBlock.isFenceBlock()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.allowInteractEntity,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "allowInteractEntity denied")
-                        );
-                    } else if (legacyBlock.mIsTrapdoor) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useTrapdoor,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useTrapdoor denied")
-                        );
-                    } else if (vftable == SignBlock::$vftable() || vftable == HangingSignBlock::$vftable()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.editSign,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "editSign denied")
-                        );
-                    } else if (vftable == ShulkerBoxBlock::$vftable()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useShulkerBox,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useShulkerBox denied")
-                        );
-                    } else if (legacyBlock.isCraftingBlock()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useCraftingTable,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useCraftingTable denied")
-                        );
-                    } else if (legacyBlock.isLeverBlock()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useLever,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useLever denied")
-                        );
-                    } else if (vftable == BlastFurnaceBlock::$vftable()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useBlastFurnace,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useBlastFurnace denied")
-                        );
-                    } else if (vftable == FurnaceBlock::$vftable()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useFurnace,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useFurnace denied")
-                        );
-                    } else if (vftable == SmokerBlock::$vftable()) {
-                        CANCEL_AND_RETURN_IF(
-                            !tab.useSmoker,
-                            EVENT_TRACE("PlayerInteractBlockEvent", EVENT_TRACE_CANCEL, "useSmoker denied")
-                        );
-                    }
                 }
             }
         );
     });
 
     RegisterListenerIf(Config::cfg.listeners.PlayerAttackEvent, [&]() {
-        return bus->emplaceListener<ll::event::PlayerAttackEvent>([db, logger](ll::event::PlayerAttackEvent& ev) {
+        return instrumentedListener<ll::event::PlayerAttackEvent>([db, logger](ll::event::PlayerAttackEvent& ev) {
             auto& player = ev.self();
             auto& mob    = ev.target();
             auto& pos    = mob.getPosition();
@@ -375,103 +346,39 @@ void EventListener::registerLLPlayerListeners() {
                 return;
             }
 
-            auto const& typeName = mob.getTypeName();
-            auto const& tab      = land->getPermTable();
+            auto const& tab = land->getPermTable();
 
-            auto hashed = HashedStringView{typeName};
-
-            if (Config::cfg.protection.mob.hostileMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowMonsterDamage,
-                    EVENT_TRACE("PlayerAttackEvent", EVENT_TRACE_CANCEL, "allowMonsterDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.specialMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowSpecialDamage,
-                    EVENT_TRACE("PlayerAttackEvent", EVENT_TRACE_CANCEL, "allowSpecialDamage denied")
-                );
-            } else if (hashed == HashedTypeName::Player) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowPlayerDamage,
-                    EVENT_TRACE("PlayerAttackEvent", EVENT_TRACE_CANCEL, "allowPlayerDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.passiveMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowPassiveDamage,
-                    EVENT_TRACE("PlayerAttackEvent", EVENT_TRACE_CANCEL, "allowPassiveDamage denied")
-                );
-            } else if (Config::cfg.protection.mob.customSpecialMobTypeNames.contains(typeName)) {
-                CANCEL_AND_RETURN_IF(
-                    !tab.allowCustomSpecialDamage,
-                    EVENT_TRACE("PlayerAttackEvent", EVENT_TRACE_CANCEL, "allowCustomSpecialDamage denied")
-                );
+            if (auto perm = MobDamageTable::lookup(mob.getTypeName()); perm && !(tab.*(perm->ptr))) {
+                EVENT_TRACE("PlayerAttackEvent", EVENT_TRACE_CANCEL, "{} denied", perm->name);
+                ev.cancel();
+                return;
             }
         });
     });
 
     RegisterListenerIf(Config::cfg.listeners.PlayerPickUpItemEvent, [&]() {
-        return bus->emplaceListener<ll::event::PlayerPickUpItemEvent>([db,
-                                                                       logger](ll::event::PlayerPickUpItemEvent& ev) {
-            auto& player = ev.self();
-            auto& item   = ev.itemActor();
-            auto& pos    = item.getPosition();
-
-            EVENT_TRACE(
-                "PlayerPickUpItemEvent",
-                EVENT_TRACE_LOG,
-                "player={}, item={}, pos={}",
-                player.getRealName(),
-                item.getTypeName(),
-                pos.toString()
-            );
-
-            auto land = db->getLandAt(pos, player.getDimensionId());
-            if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                EVENT_TRACE("PlayerPickUpItemEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                return;
-            }
-
-            if (land->getPermTable().allowPickupItem) {
-                EVENT_TRACE("PlayerPickUpItemEvent", EVENT_TRACE_PASS, "allowPickupItem allowed");
-                return;
-            }
-
-            ev.cancel();
-            EVENT_TRACE("PlayerPickUpItemEvent", EVENT_TRACE_CANCEL, "allowPickupItem denied");
-        });
+        return emplaceRule(makeRule<ll::event::PlayerPickUpItemEvent>(
+            "PlayerPickUpItemEvent",
+            [](ll::event::PlayerPickUpItemEvent& ev) {
+                return std::optional<RuleTarget>{{ev.itemActor().getPosition(), ev.self().getDimensionId()}};
+            },
+            rule_identity::Self,
+            &LandPermTable::allowPickupItem
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.PlayerUseItemEvent, [&]() {
-        return bus->emplaceListener<ll::event::PlayerUseItemEvent>([db, logger](ll::event::PlayerUseItemEvent& ev) {
-            auto& player = ev.self();
-            auto& item   = ev.item();
-
-            auto  typeName = item.getTypeName();
-            auto& pos      = player.getPosition();
-
-            EVENT_TRACE(
-                "PlayerUseItemEvent",
-                EVENT_TRACE_LOG,
-                "player={}, item={}, pos={}",
-                player.getRealName(),
-                typeName,
-                pos.toString()
-            );
-
-            auto land = db->getLandAt(pos, player.getDimensionId());
-            if (PreCheckLandExistsAndPermission(land, player.getUuid())) {
-                EVENT_TRACE("PlayerUseItemEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                return;
+        return emplaceRule(makeRule<ll::event::PlayerUseItemEvent>(
+            "PlayerUseItemEvent",
+            [](ll::event::PlayerUseItemEvent& ev) {
+                return std::optional<RuleTarget>{{ev.self().getPosition(), ev.self().getDimensionId()}};
+            },
+            rule_identity::Self,
+            [](ll::event::PlayerUseItemEvent& ev, LandPermTable const& tab) {
+                // patch https://github.com/engsr6982/PLand/issues/139
+                return tab.allowProjectileCreate || HashedStringView{ev.item().getTypeName()} != HashedTypeName::Trident;
             }
-
-            auto hashed = HashedStringView{typeName};
-
-            // patch https://github.com/engsr6982/PLand/issues/139
-            CANCEL_AND_RETURN_IF(
-                !land->getPermTable().allowProjectileCreate && hashed == HashedTypeName::Trident,
-                EVENT_TRACE("PlayerUseItemEvent", EVENT_TRACE_CANCEL, "allowProjectileCreate denied")
-            );
-        });
+        ));
     });
 }
 
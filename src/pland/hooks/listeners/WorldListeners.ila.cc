@@ -1,5 +1,6 @@
 
 #include "pland/hooks/EventListener.h"
+#include "pland/hooks/ProtectionRule.h"
 #include "pland/hooks/listeners/ListenerHelper.h"
 
 #include "ll/api/event/EventBus.h"
@@ -21,80 +22,59 @@
 #include "mc/world/phys/AABB.h"
 
 #include "pland/PLand.h"
+#include "pland/hooks/optimize/ExplosionEvaluator.h"
 #include "pland/infra/Config.h"
 #include "pland/land/LandRegistry.h"
 
+#include <optional>
+
 namespace land {
 
 void EventListener::registerILAWorldListeners() {
     auto* db     = &PLand::getInstance().getLandRegistry();
-    auto* bus    = &ll::event::EventBus::getInstance();
     auto* logger = &land::PLand::getInstance().getSelf().getLogger();
 
 
     RegisterListenerIf(Config::cfg.listeners.ExplosionBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::ExplosionBeforeEvent>([db, logger](ila::mc::ExplosionBeforeEvent& ev) {
-            auto       explosionPos = BlockPos{ev.explosion().mPos};
-            auto       dimid        = ev.blockSource().getDimensionId();
-            SharedLand centerLand   = db->getLandAt(explosionPos, dimid);
+        return instrumentedListener<ila::mc::ExplosionBeforeEvent>([db, logger](ila::mc::ExplosionBeforeEvent& ev) {
+            auto& explosion    = ev.explosion();
+            auto  explosionPos = BlockPos{explosion.mPos};
+            auto  dimid        = ev.blockSource().getDimensionId();
 
             EVENT_TRACE("ExplosionEvent", EVENT_TRACE_LOG, "pos={}", explosionPos.toString());
 
-            if (centerLand) {
-                // 规则一：爆炸中心所在领地的权限具有决定性。
-                if (!centerLand->getPermTable().allowExplode) {
-                    EVENT_TRACE("ExplosionEvent", EVENT_TRACE_CANCEL, "center land does not allow explode");
-                    ev.cancel();
-                    return;
-                }
+            ExplosionEvaluator evaluator{*db, dimid, explosionPos, explosion.mRadius + 1.0f};
 
-                // 规则二：如果中心领地允许爆炸，检查是否影响到其他禁止爆炸的、不相关的领地。
-                auto touchedLands = db->getLandAt(explosionPos, (int)(ev.explosion().mRadius + 1.0), dimid);
-                auto centerRoot   = centerLand->getRootLand();
-                for (auto const& touchedLand : touchedLands) {
-                    if (touchedLand->getRootLand() != centerRoot) {
-                        if (!touchedLand->getPermTable().allowExplode) {
-                            EVENT_TRACE("ExplosionEvent", EVENT_TRACE_CANCEL, "touched land does not allow explode");
-                            ev.cancel();
-                            return;
-                        }
-                    }
-                }
-            } else {
-                // 情况：爆炸发生在领地外。
-                // 如果影响到任何禁止爆炸的领地，则取消。
-                auto touchedLands = db->getLandAt(explosionPos, (int)(ev.explosion().mRadius + 1.0), dimid);
-                for (auto const& touchedLand : touchedLands) {
-                    if (!touchedLand->getPermTable().allowExplode) {
-                        EVENT_TRACE("ExplosionEvent", EVENT_TRACE_CANCEL, "external land does not allow explode");
-                        ev.cancel();
-                        return;
-                    }
-                }
+            // 规则一：爆炸中心所在领地的权限具有决定性。
+            if (evaluator.isCenterProtected()) {
+                EVENT_TRACE("ExplosionEvent", EVENT_TRACE_CANCEL, "center land does not allow explode");
+                ev.cancel();
+                return;
+            }
+
+            // 规则二：检查是否影响到其他禁止爆炸的、不相关的领地。
+            // 事件触发时受影响方块尚未计算，按爆炸范围与领地范围相交判断
+            if (evaluator.touchesProtectedLand()) {
+                EVENT_TRACE("ExplosionEvent", EVENT_TRACE_CANCEL, "touched land does not allow explode");
+                ev.cancel();
             }
         });
     });
 
 
     RegisterListenerIf(Config::cfg.listeners.FarmDecayBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::FarmDecayBeforeEvent>([db, logger](ila::mc::FarmDecayBeforeEvent& ev) {
-            auto& pos = ev.pos();
-
-            EVENT_TRACE("FarmDecayEvent", EVENT_TRACE_LOG, "pos={}", pos.toString());
-
-            auto land = db->getLandAt(pos, ev.blockSource().getDimensionId());
-            if (PreCheckLandExistsAndPermission(land) || land->getPermTable().allowFarmDecay) {
-                EVENT_TRACE("FarmDecayEvent", EVENT_TRACE_PASS, "land not found or permission allowed");
-                return;
-            }
-
-            ev.cancel();
-            EVENT_TRACE("FarmDecayEvent", EVENT_TRACE_CANCEL, "permission denied");
-        });
+        return emplaceRule(makeRule<ila::mc::FarmDecayBeforeEvent>(
+            "FarmDecayEvent",
+            [](ila::mc::FarmDecayBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.blockSource().getDimensionId()}};
+            },
+            rule_identity::None,
+            &LandPermTable::allowFarmDecay
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.PistonPushBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::PistonPushBeforeEvent>([db](ila::mc::PistonPushBeforeEvent& ev) {
+        return instrumentedListener<ila::mc::PistonPushBeforeEvent>([db](ila::mc::PistonPushBeforeEvent& ev) {
             auto const& piston     = ev.pistonPos();
             auto const& push       = ev.pushPos();
             auto const  dimid      = ev.blockSource().getDimensionId();
@@ -117,15 +97,18 @@ void EventListener::registerILAWorldListeners() {
     });
 
     RegisterListenerIf(Config::cfg.listeners.RedstoneUpdateBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::RedstoneUpdateBeforeEvent>([db](ila::mc::RedstoneUpdateBeforeEvent& ev) {
-            auto land = db->getLandAt(ev.pos(), ev.blockSource().getDimensionId());
-            if (PreCheckLandExistsAndPermission(land) || (land && land->getPermTable().allowRedstoneUpdate)) return;
-            ev.cancel();
-        });
+        return emplaceRule(makeRule<ila::mc::RedstoneUpdateBeforeEvent>(
+            "RedstoneUpdateEvent",
+            [](ila::mc::RedstoneUpdateBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.blockSource().getDimensionId()}};
+            },
+            rule_identity::None,
+            &LandPermTable::allowRedstoneUpdate
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.BlockFallBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::BlockFallBeforeEvent>([db](ila::mc::BlockFallBeforeEvent& ev) {
+        return instrumentedListener<ila::mc::BlockFallBeforeEvent>([db](ila::mc::BlockFallBeforeEvent& ev) {
             auto land = db->getLandAt(ev.pos(), ev.blockSource().getDimensionId());
             if (land) {
                 auto const& tab = land->getPermTable();
@@ -137,7 +120,7 @@ void EventListener::registerILAWorldListeners() {
     });
 
     RegisterListenerIf(Config::cfg.listeners.WitherDestroyBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::WitherDestroyBeforeEvent>([db,
+        return instrumentedListener<ila::mc::WitherDestroyBeforeEvent>([db,
                                                                         logger](ila::mc::WitherDestroyBeforeEvent& ev) {
             auto& aabb = ev.box();
 
@@ -157,7 +140,7 @@ void EventListener::registerILAWorldListeners() {
     });
 
     RegisterListenerIf(Config::cfg.listeners.MossGrowthBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::MossGrowthBeforeEvent>([db](ila::mc::MossGrowthBeforeEvent& ev) {
+        return instrumentedListener<ila::mc::MossGrowthBeforeEvent>([db](ila::mc::MossGrowthBeforeEvent& ev) {
             auto const& pos  = ev.pos();
             auto        land = db->getLandAt(pos, ev.blockSource().getDimensionId());
             if (!land || land->getPermTable().useBoneMeal) return;
@@ -170,7 +153,7 @@ void EventListener::registerILAWorldListeners() {
     });
 
     RegisterListenerIf(Config::cfg.listeners.LiquidFlowBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::LiquidFlowBeforeEvent>([db](ila::mc::LiquidFlowBeforeEvent& ev) {
+        return instrumentedListener<ila::mc::LiquidFlowBeforeEvent>([db](ila::mc::LiquidFlowBeforeEvent& ev) {
             auto& sou    = ev.flowFromPos();
             auto& to     = ev.pos();
             auto  landTo = db->getLandAt(to, ev.blockSource().getDimensionId());
@@ -182,29 +165,29 @@ void EventListener::registerILAWorldListeners() {
     });
 
     RegisterListenerIf(Config::cfg.listeners.DragonEggBlockTeleportBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::DragonEggBlockTeleportBeforeEvent>(
-            [db](ila::mc::DragonEggBlockTeleportBeforeEvent& ev) {
-                auto land = db->getLandAt(ev.pos(), ev.blockSource().getDimensionId());
-                if (land && !land->getPermTable().allowAttackDragonEgg) {
-                    ev.cancel();
-                }
-            }
-        );
+        return emplaceRule(makeRule<ila::mc::DragonEggBlockTeleportBeforeEvent>(
+            "DragonEggBlockTeleportEvent",
+            [](ila::mc::DragonEggBlockTeleportBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.blockSource().getDimensionId()}};
+            },
+            rule_identity::None,
+            &LandPermTable::allowAttackDragonEgg
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.SculkBlockGrowthBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::SculkBlockGrowthBeforeEvent>(
-            [db](ila::mc::SculkBlockGrowthBeforeEvent& ev) {
-                auto land = db->getLandAt(ev.pos(), ev.blockSource().getDimensionId());
-                if (land && !land->getPermTable().allowSculkBlockGrowth) {
-                    ev.cancel();
-                }
-            }
-        );
+        return emplaceRule(makeRule<ila::mc::SculkBlockGrowthBeforeEvent>(
+            "SculkBlockGrowthEvent",
+            [](ila::mc::SculkBlockGrowthBeforeEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.blockSource().getDimensionId()}};
+            },
+            rule_identity::None,
+            &LandPermTable::allowSculkBlockGrowth
+        ));
     });
 
     RegisterListenerIf(Config::cfg.listeners.SculkSpreadBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::SculkSpreadBeforeEvent>([db](ila::mc::SculkSpreadBeforeEvent& ev) {
+        return instrumentedListener<ila::mc::SculkSpreadBeforeEvent>([db](ila::mc::SculkSpreadBeforeEvent& ev) {
             auto sou = db->getLandAt(ev.selfPos(), ev.blockSource().getDimensionId());
             auto tar = db->getLandAt(ev.targetPos(), ev.blockSource().getDimensionId());
             if (!sou && tar) {
@@ -214,7 +197,7 @@ void EventListener::registerILAWorldListeners() {
     });
 
     RegisterListenerIf(Config::cfg.listeners.SculkCatalystAbsorbExperienceBeforeEvent, [&]() {
-        return bus->emplaceListener<ila::mc::SculkCatalystAbsorbExperienceBeforeEvent>(
+        return instrumentedListener<ila::mc::SculkCatalystAbsorbExperienceBeforeEvent>(
             [db](ila::mc::SculkCatalystAbsorbExperienceBeforeEvent& ev) {
                 auto& actor  = ev.actor();
                 auto& region = actor.getDimensionBlockSource();
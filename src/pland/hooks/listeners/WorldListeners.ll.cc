@@ -1,5 +1,6 @@
 
 #include "pland/hooks/EventListener.h"
+#include "pland/hooks/ProtectionRule.h"
 #include "pland/hooks/listeners/ListenerHelper.h"
 
 #include "ll/api/event/EventBus.h"
@@ -9,22 +10,20 @@
 #include "pland/infra/Config.h"
 #include "pland/land/LandRegistry.h"
 
+#include <optional>
+
 namespace land {
 
 void EventListener::registerLLWorldListeners() {
-    auto* db     = &PLand::getInstance().getLandRegistry();
-    auto* bus    = &ll::event::EventBus::getInstance();
-    auto* logger = &land::PLand::getInstance().getSelf().getLogger();
-
     RegisterListenerIf(Config::cfg.listeners.FireSpreadEvent, [&]() {
-        return bus->emplaceListener<ll::event::FireSpreadEvent>([db](ll::event::FireSpreadEvent& ev) {
-            auto& pos  = ev.pos();
-            auto  land = db->getLandAt(pos, ev.blockSource().getDimensionId());
-            if (PreCheckLandExistsAndPermission(land) || (land && land->getPermTable().allowFireSpread)) {
-                return;
-            }
-            ev.cancel();
-        });
+        return emplaceRule(makeRule<ll::event::FireSpreadEvent>(
+            "FireSpreadEvent",
+            [](ll::event::FireSpreadEvent& ev) {
+                return std::optional<RuleTarget>{{ev.pos(), ev.blockSource().getDimensionId()}};
+            },
+            rule_identity::None,
+            &LandPermTable::allowFireSpread
+        ));
     });
 }
 
@@ -0,0 +1,75 @@
+#include "pland/hooks/optimize/ExplosionEvaluator.h"
+#include "pland/aabb/LandAABB.h"
+#include "pland/land/LandRegistry.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace land {
+
+static constexpr auto InvalidLandID = LandID(-1);
+
+
+ExplosionEvaluator::ExplosionEvaluator(LandRegistry& registry, LandDimid dimid, BlockPos const& center, float radius)
+: mRegistry(registry),
+  mDimid(dimid),
+  mCenter(center),
+  mRadius(radius),
+  mCenterLand(registry.getLandAt(center, dimid)),
+  mCenterRoot(mCenterLand ? _rootOf(mCenterLand) : InvalidLandID) {}
+
+LandID ExplosionEvaluator::_rootOf(SharedLand const& land) {
+    auto id = land->getId();
+    if (auto iter = mRootCache.find(id); iter != mRootCache.end()) {
+        return iter->second;
+    }
+    auto root   = land->getRootLand();
+    auto rootId = root ? root->getId() : id;
+    mRootCache.emplace(id, rootId);
+    return rootId;
+}
+
+bool ExplosionEvaluator::_intersectsSphere(Land const& land) const {
+    // 球心到 AABB 最近点的距离(2D 领地忽略 Y 轴)
+    auto const& aabb = land.getAABB();
+
+    auto axis = [](int value, int min, int max) {
+        auto nearest = std::clamp(value, min, max);
+        return static_cast<double>(value - nearest);
+    };
+    double dx = axis(mCenter.x, aabb.min.x, aabb.max.x);
+    double dz = axis(mCenter.z, aabb.min.z, aabb.max.z);
+    double dy = land.is3D() ? axis(mCenter.y, aabb.min.y, aabb.max.y) : 0.0;
+    return dx * dx + dy * dy + dz * dz <= static_cast<double>(mRadius) * mRadius;
+}
+
+bool ExplosionEvaluator::isCenterProtected() const { return mCenterLand && !mCenterLand->getPermTable().allowExplode; }
+
+bool ExplosionEvaluator::isProtected(SharedLand const& land) {
+    auto id = land->getId();
+    if (auto iter = mProtectedCache.find(id); iter != mProtectedCache.end()) {
+        return iter->second;
+    }
+
+    bool result = !land->getPermTable().allowExplode && (!mCenterLand || _rootOf(land) != mCenterRoot);
+    mProtectedCache.emplace(id, result);
+    return result;
+}
+
+bool ExplosionEvaluator::touchesProtectedLand() {
+    auto reach = static_cast<int>(std::ceil(mRadius));
+    auto range = LandAABB{
+        LandPos{mCenter.x - reach, mCenter.y - reach, mCenter.z - reach},
+        LandPos{mCenter.x + reach, mCenter.y + reach, mCenter.z + reach}
+    };
+    for (auto const& land : mRegistry.getLandsIntersecting(range, mDimid)) {
+        if (_intersectsSphere(*land) && isProtected(land)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+} // namespace land
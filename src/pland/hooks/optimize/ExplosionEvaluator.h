@@ -0,0 +1,61 @@
+#pragma once
+#include "pland/Global.h"
+#include "pland/land/Land.h"
+
+#include "mc/world/level/BlockPos.h"
+
+#include <unordered_map>
+
+namespace land {
+
+class LandRegistry;
+
+
+/**
+ * @brief 爆炸保护评估
+ *
+ * 规则与原先一致:
+ * 1. 爆炸中心所在领地禁止爆炸时，整个爆炸取消
+ * 2. 中心在领地内时，与中心不同根(不属于同一领地家族)且禁止爆炸的领地受保护
+ * 3. 中心不在领地内时，所有禁止爆炸的领地受保护
+ *
+ * 每次评估内缓存各领地的根领地ID与保护结果，同一领地只计算一次。
+ */
+class ExplosionEvaluator final {
+    LandRegistry&                      mRegistry;
+    LandDimid                          mDimid;
+    BlockPos                           mCenter;
+    float                              mRadius;
+    std::unordered_map<LandID, LandID> mRootCache;      // 领地 -> 根领地
+    std::unordered_map<LandID, bool>   mProtectedCache; // 领地 -> 是否受保护
+    SharedLand                         mCenterLand;     // 需在缓存之后初始化
+    LandID                             mCenterRoot;
+
+    LandID _rootOf(SharedLand const& land);
+    bool   _intersectsSphere(Land const& land) const;
+
+public:
+    LD_DISABLE_COPY_AND_MOVE(ExplosionEvaluator);
+    explicit ExplosionEvaluator(LandRegistry& registry, LandDimid dimid, BlockPos const& center, float radius);
+
+    [[nodiscard]] SharedLand const& getCenterLand() const { return mCenterLand; }
+
+    /**
+     * @brief 爆炸中心所在领地是否禁止爆炸
+     */
+    [[nodiscard]] bool isCenterProtected() const;
+
+    /**
+     * @brief 领地是否受保护(不允许被此次爆炸影响)
+     */
+    [[nodiscard]] bool isProtected(SharedLand const& land);
+
+    /**
+     * @brief 按爆炸范围(球体)与领地范围的相交情况判断是否影响受保护领地
+     * 用于爆炸尚未计算受影响方块的场景，耗时只与附近领地数量有关
+     */
+    [[nodiscard]] bool touchesProtectedLand();
+};
+
+
+} // namespace land
@@ -0,0 +1,69 @@
+#include "pland/hooks/optimize/MobDamageTable.h"
+#include "pland/hooks/optimize/HashedTypeName.h"
+#include "pland/infra/Config.h"
+
+#include "mc/world/actor/Actor.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+
+namespace land {
+
+namespace {
+
+using Permission = MobDamageTable::Permission;
+
+constexpr Permission Hostile{&LandPermTable::allowMonsterDamage, "allowMonsterDamage"};
+constexpr Permission Special{&LandPermTable::allowSpecialDamage, "allowSpecialDamage"};
+constexpr Permission Player{&LandPermTable::allowPlayerDamage, "allowPlayerDamage"};
+constexpr Permission Passive{&LandPermTable::allowPassiveDamage, "allowPassiveDamage"};
+constexpr Permission CustomSpecial{&LandPermTable::allowCustomSpecialDamage, "allowCustomSpecialDamage"};
+
+// 键为类型名哈希(与 HashedStringView 相同)，值指向上面的常量
+struct IdentityHash {
+    size_t operator()(uint64_t hash) const noexcept { return static_cast<size_t>(hash); }
+};
+std::unordered_map<uint64_t, Permission const*, IdentityHash> Table;
+
+} // namespace
+
+
+void MobDamageTable::rebuild() {
+    auto const& mob = Config::cfg.protection.mob;
+
+    Table.clear();
+    Table.reserve(
+        mob.hostileMobTypeNames.size() + mob.specialMobTypeNames.size() + mob.passiveMobTypeNames.size()
+        + mob.customSpecialMobTypeNames.size() + 1
+    );
+
+    // 按优先级插入，已存在的键不会被覆盖
+    auto insert = [](auto const& names, Permission const& perm) {
+        for (auto const& name : names) {
+            Table.emplace(HashedStringView{name}.mHash, &perm);
+        }
+    };
+    insert(mob.hostileMobTypeNames, Hostile);
+    insert(mob.specialMobTypeNames, Special);
+    Table.emplace(HashedTypeName::Player.mHash, &Player);
+    insert(mob.passiveMobTypeNames, Passive);
+    insert(mob.customSpecialMobTypeNames, CustomSpecial);
+}
+
+MobDamageTable::Permission const* MobDamageTable::lookup(std::string_view typeName) {
+    if (auto iter = Table.find(HashedStringView{typeName}.mHash); iter != Table.end()) {
+        return iter->second;
+    }
+    return nullptr;
+}
+
+MobDamageTable::Permission const* MobDamageTable::lookup(Actor const& actor) {
+    if (actor.isPlayer()) {
+        return &Player;
+    }
+    return lookup(actor.getTypeName());
+}
+
+
+} // namespace land
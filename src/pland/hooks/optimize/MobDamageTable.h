@@ -0,0 +1,43 @@
+#pragma once
+#include "pland/Global.h"
+#include "pland/land/LandContext.h"
+
+#include <string_view>
+
+class Actor;
+
+namespace land {
+
+
+/**
+ * @brief 生物伤害权限分类表
+ *
+ * 配置加载/重载时将 protection.mob 中的各类生物名单编译为 类型名哈希 -> 权限位 的单表，
+ * 监听器每次只需计算一次哈希、查询一次，不再依次探测多个字符串集合。
+ * 优先级与原先的判断顺序一致: hostile > special > player > passive > customSpecial
+ */
+class MobDamageTable final {
+public:
+    struct Permission {
+        bool LandPermTable::* ptr;
+        std::string_view      name; // 权限名(用于日志)
+    };
+
+    /**
+     * @brief 从 Config::cfg 重建分类表
+     */
+    LDAPI static void rebuild();
+
+    /**
+     * @brief 查询生物受伤需要检查的权限，未分类返回 nullptr
+     */
+    LDNDAPI static Permission const* lookup(std::string_view typeName);
+
+    /**
+     * @brief 同 lookup(typeName)，但玩家始终归为 allowPlayerDamage
+     */
+    LDNDAPI static Permission const* lookup(Actor const& actor);
+};
+
+
+} // namespace land
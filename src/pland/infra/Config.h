@@ -18,7 +18,7 @@ struct ForbiddenRange {
 };
 
 struct Config {
-    int              version{31};
+    int              version{36};
     ll::io::LogLevel logLevel{ll::io::LogLevel::Info};
 
     EconomyConfig economy;
@@ -36,6 +36,26 @@ struct Config {
 
         DrawerType drawHandleBackend{DrawerType::DebugShape}; // 领地绘制后端
 
+        // 默认粒子绘制后端
+        struct {
+            int viewDistance{64}; // 可视距离，超出此距离的边线不发送粒子
+            int lodDistance{16};  // 超出此距离后，按距离增大粒子采样步长
+            int maxStride{8};     // 最大采样步长
+        } particleDrawer;
+
+        // 绘制数据包调度
+        struct {
+            int maxPacketsPerTick{2048};         // 所有玩家每 tick 最多发送的数据包数量
+            int maxPacketsPerPlayerPerTick{256}; // 每个玩家每 tick 最多发送的数据包数量
+            int maxQueuedPerPlayer{4096};        // 每个玩家最多排队的发送任务，超出后丢弃最旧的任务
+        } drawScheduler;
+
+        // 附近领地跟随绘制 (/pland draw follow_near_land)
+        struct {
+            int updateInterval{1000}; // 最短更新间隔(ms)
+            int moveThreshold{4};     // 玩家移动超过此距离才重新计算附近领地
+        } drawFollow;
+
         struct {
             bool        enabled{false};                              // 是否启用
             int         maxNested{5};                                // 最大嵌套层数(默认5，最大16)
@@ -201,8 +221,10 @@ struct Config {
     } protection;
 
     struct {
-        bool telemetry{true}; // 遥测（匿名数据统计）
-        bool devTools{false}; // 开发工具
+        bool     telemetry{true};         // 遥测（匿名数据统计）
+        bool     devTools{false};         // 开发工具
+        bool     listenerStats{false};    // 监听器性能统计
+        uint32_t eventTraceSampleRate{0}; // 事件追踪采样率(每 N 个事件记录 1 个, 0 为关闭)
     } internal;
 
 
@@ -157,22 +157,26 @@ SharedLand iLandConverter::convert(RawData::iLand const& raw, std::string const&
     return Land::make(std::move(ctx));
 }
 
-bool iLandConverter::execute() {
+bool iLandConverter::parse() {
     auto rawRelationShipJSON = loadJson(mRelationShipPath);
     auto rawDataJSON         = loadJson(mDataPath);
     if (!rawRelationShipJSON || !rawDataJSON) {
         return false;
     }
 
-    auto& logger = land::PLand::getInstance().getSelf().getLogger();
     // 反射
     json_util::json2structWithDiffPatch(*rawRelationShipJSON, mRelationShip);
     json_util::json2structWithDiffPatch(*rawDataJSON, mData);
     if (mRelationShip.version != 284 || mData.version != 284) {
-        logger.warn(
+        land::PLand::getInstance().getSelf().getLogger().warn(
             "The version of the data file does not match the current version, the conversion may not be accurate"
         );
     }
+    return true;
+}
+
+bool iLandConverter::apply() {
+    auto& logger = land::PLand::getInstance().getSelf().getLogger();
 
     auto const& data  = mData.Lands;
     auto&       infos = ll::service::PlayerInfo::getInstance();
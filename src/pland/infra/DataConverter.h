@@ -32,7 +32,18 @@ class DataConverter {
 
     void writeToDb(std::vector<SharedLand> const& data);
 
-    virtual bool execute() = 0;
+    /**
+     * @brief 读取并解析源数据，不访问注册表与游戏 API，可在后台线程执行
+     */
+    virtual bool parse() = 0;
+
+    /**
+     * @brief 转换已解析的数据并写入注册表
+     * @note 需在服务器线程调用
+     */
+    virtual bool apply() = 0;
+
+    bool execute() { return parse() && apply(); }
 };
 
 
@@ -142,7 +153,9 @@ class iLandConverter : public DataConverter {
 
     SharedLand convert(RawData::iLand const& raw, std::string const& xuid, std::optional<mce::UUID> uuids);
 
-    bool execute() override;
+    bool parse() override;
+
+    bool apply() override;
 };
 
 
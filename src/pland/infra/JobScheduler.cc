@@ -0,0 +1,204 @@
+#include "pland/infra/JobScheduler.h"
+#include "pland/PLand.h"
+
+#include "ll/api/thread/ThreadPoolExecutor.h"
+
+#include "fmt/core.h"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace land {
+
+namespace {
+
+template <typename T>
+void atomicMax(std::atomic<T>& target, T value) {
+    auto current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+bool isFinished(JobScheduler::JobState state) {
+    return state != JobScheduler::JobState::Pending && state != JobScheduler::JobState::Running;
+}
+
+} // namespace
+
+
+JobScheduler::JobState JobScheduler::Handle::state() const {
+    return mJob ? mJob->state.load(std::memory_order_acquire) : JobState::Cancelled;
+}
+
+bool JobScheduler::Handle::cancel() const {
+    if (!mJob) {
+        return false;
+    }
+    auto expected = JobState::Pending;
+    if (!mJob->state.compare_exchange_strong(expected, JobState::Cancelled, std::memory_order_acq_rel)) {
+        return false;
+    }
+    mJob->state.notify_all();
+    return true;
+}
+
+void JobScheduler::Handle::wait() const {
+    if (!mJob) {
+        return;
+    }
+    auto state = mJob->state.load(std::memory_order_acquire);
+    while (!isFinished(state)) {
+        mJob->state.wait(state, std::memory_order_acquire);
+        state = mJob->state.load(std::memory_order_acquire);
+    }
+}
+
+
+JobScheduler::JobScheduler(ll::thread::ThreadPoolExecutor& pool, size_t concurrency)
+: mPool(pool),
+  mConcurrency(std::max<size_t>(concurrency, 1)) {}
+
+JobScheduler::~JobScheduler() {
+    std::unique_lock lock(mMutex);
+    mStopping = true;
+    for (size_t i = 0; i < PriorityCount; ++i) {
+        for (auto& job : mQueues[i]) {
+            if (Handle{job}.cancel()) {
+                mCounters[i].cancelled.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        mQueues[i].clear();
+    }
+    mIdleCV.wait(lock, [this] { return mRunning == 0; });
+}
+
+std::shared_ptr<JobScheduler::Job> JobScheduler::_pop() {
+    for (auto& queue : mQueues) {
+        if (!queue.empty()) {
+            auto job = std::move(queue.front());
+            queue.pop_front();
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobScheduler::_pump() {
+    for (;;) {
+        std::shared_ptr<Job> job;
+        {
+            std::lock_guard lock(mMutex);
+            job = _pop();
+            if (!job) {
+                --mRunning;
+                mIdleCV.notify_all(); // 持锁通知，析构方在锁释放后才能继续
+                return;
+            }
+        }
+
+        auto& counters = mCounters[static_cast<size_t>(job->priority)];
+        auto  expected = JobState::Pending;
+        if (job->deadline && Clock::now() > *job->deadline) {
+            if (job->state.compare_exchange_strong(expected, JobState::Expired, std::memory_order_acq_rel)) {
+                job->state.notify_all();
+                counters.expired.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                counters.cancelled.fetch_add(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
+        if (!job->state.compare_exchange_strong(expected, JobState::Running, std::memory_order_acq_rel)) {
+            counters.cancelled.fetch_add(1, std::memory_order_relaxed); // 排队期间已被取消
+            continue;
+        }
+
+        auto begin = Clock::now();
+        try {
+            job->fn();
+        } catch (std::exception const& e) {
+            PLand::getInstance().getSelf().getLogger().error(
+                "An exception occurred while running job '{}': {}",
+                job->name,
+                e.what()
+            );
+        } catch (...) {
+            PLand::getInstance().getSelf().getLogger().error(
+                "An unknown exception occurred while running job '{}'",
+                job->name
+            );
+        }
+        auto elapsed = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count()
+        );
+        counters.completed.fetch_add(1, std::memory_order_relaxed);
+        counters.totalRunNs.fetch_add(elapsed, std::memory_order_relaxed);
+        atomicMax(counters.maxRunNs, elapsed);
+
+        job->fn = nullptr; // 尽早释放捕获的资源
+        job->state.store(JobState::Done, std::memory_order_release);
+        job->state.notify_all();
+    }
+}
+
+ll::Expected<JobScheduler::Handle>
+JobScheduler::submit(std::string name, std::function<void()> fn, Options options) {
+    auto const index = static_cast<size_t>(options.priority);
+
+    auto job      = std::make_shared<Job>();
+    job->name     = std::move(name);
+    job->fn       = std::move(fn);
+    job->priority = options.priority;
+    job->deadline = options.deadline;
+
+    bool spawn = false;
+    {
+        std::lock_guard lock(mMutex);
+        if (mStopping) {
+            return ll::makeStringError(fmt::format("Job scheduler is stopping, job '{}' rejected", job->name));
+        }
+        if (mQueues[index].size() >= QueueCapacity[index]) {
+            mCounters[index].rejected.fetch_add(1, std::memory_order_relaxed);
+            return ll::makeStringError(fmt::format("Job queue is full, job '{}' rejected", job->name));
+        }
+        mQueues[index].push_back(job);
+        mCounters[index].submitted.fetch_add(1, std::memory_order_relaxed);
+        if (mRunning < mConcurrency) {
+            ++mRunning;
+            spawn = true;
+        }
+    }
+    if (spawn) {
+        mPool.execute([this] { _pump(); });
+    }
+    return Handle{std::move(job)};
+}
+
+size_t JobScheduler::getConcurrency() const { return mConcurrency; }
+
+std::array<JobScheduler::Stats, JobScheduler::PriorityCount> JobScheduler::getStats() const {
+    std::array<Stats, PriorityCount> result{};
+    {
+        std::lock_guard lock(mMutex);
+        for (size_t i = 0; i < PriorityCount; ++i) {
+            result[i].depth = mQueues[i].size();
+        }
+    }
+    for (size_t i = 0; i < PriorityCount; ++i) {
+        auto const& counters = mCounters[i];
+        auto&       stats    = result[i];
+        stats.priority       = static_cast<Priority>(i);
+        stats.submitted      = counters.submitted.load(std::memory_order_relaxed);
+        stats.completed      = counters.completed.load(std::memory_order_relaxed);
+        stats.cancelled      = counters.cancelled.load(std::memory_order_relaxed);
+        stats.expired        = counters.expired.load(std::memory_order_relaxed);
+        stats.rejected       = counters.rejected.load(std::memory_order_relaxed);
+        stats.maxRunNs       = counters.maxRunNs.load(std::memory_order_relaxed);
+        if (stats.completed != 0) {
+            stats.meanRunNs = counters.totalRunNs.load(std::memory_order_relaxed) / stats.completed;
+        }
+    }
+    return result;
+}
+
+
+} // namespace land
@@ -0,0 +1,158 @@
+#pragma once
+#include "pland/Global.h"
+
+#include "ll/api/Expected.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace ll::thread {
+class ThreadPoolExecutor;
+}
+
+namespace land {
+
+
+/**
+ * @brief 后台任务调度器
+ *
+ * 在 PLand 线程池之上按优先级排队执行后台任务，同时运行的任务数不超过并发上限(为异步查询等直接提交到线程池的任务留出线程)。
+ * 支持取消(尚未开始的任务)、截止时间(超时未开始则放弃)与背压(队列满时拒绝提交)，并统计队列深度与运行耗时。
+ */
+class JobScheduler final {
+public:
+    enum class Priority : uint8_t {
+        High = 0, // 数据保存
+        Normal,   // 索引重建、数据导入
+        Low,      // 遥测、统计
+    };
+    static constexpr size_t PriorityCount = 3;
+
+    // 各优先级队列容量，超出时拒绝提交
+    static constexpr std::array<size_t, PriorityCount> QueueCapacity = {1024, 256, 64};
+
+    enum class JobState : uint8_t {
+        Pending,   // 排队中
+        Running,   // 运行中
+        Done,      // 已完成
+        Cancelled, // 已取消
+        Expired,   // 超过截止时间未开始
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        Priority                         priority{Priority::Normal};
+        std::optional<Clock::time_point> deadline{std::nullopt}; // 截止时间，超过仍未开始则放弃
+    };
+
+    struct Stats {
+        Priority priority;
+        size_t   depth{0};     // 当前排队数
+        uint64_t submitted{0}; // 已提交
+        uint64_t completed{0}; // 已完成
+        uint64_t cancelled{0}; // 已取消
+        uint64_t expired{0};   // 已过期
+        uint64_t rejected{0};  // 因队列满被拒绝
+        uint64_t meanRunNs{0};
+        uint64_t maxRunNs{0};
+    };
+
+private:
+    struct Job {
+        std::string                      name;
+        std::function<void()>            fn;
+        Priority                         priority;
+        std::optional<Clock::time_point> deadline;
+        std::atomic<JobState>            state{JobState::Pending};
+    };
+
+    struct Counters {
+        std::atomic<uint64_t> submitted{0};
+        std::atomic<uint64_t> completed{0};
+        std::atomic<uint64_t> cancelled{0};
+        std::atomic<uint64_t> expired{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> totalRunNs{0};
+        std::atomic<uint64_t> maxRunNs{0};
+    };
+
+public:
+    /**
+     * @brief 任务句柄
+     */
+    class Handle {
+        std::shared_ptr<Job> mJob;
+
+    public:
+        Handle() = default;
+        explicit Handle(std::shared_ptr<Job> job) : mJob(std::move(job)) {}
+
+        [[nodiscard]] bool valid() const { return mJob != nullptr; }
+
+        LDNDAPI JobState state() const;
+
+        /**
+         * @brief 取消任务，仅对尚未开始的任务有效
+         */
+        LDAPI bool cancel() const;
+
+        /**
+         * @brief 等待任务结束(完成、取消或过期)
+         */
+        LDAPI void wait() const;
+    };
+
+private:
+    ll::thread::ThreadPoolExecutor&                             mPool;
+    size_t const                                                mConcurrency;     // 并发上限
+    mutable std::mutex                                          mMutex;           // 保护队列与运行计数
+    std::condition_variable                                     mIdleCV;          // 运行中的任务全部退出时通知
+    std::array<std::deque<std::shared_ptr<Job>>, PriorityCount> mQueues;          // 按优先级排队
+    std::array<Counters, PriorityCount>                         mCounters;
+    size_t                                                      mRunning{0};      // 正在运行的工作者数
+    bool                                                        mStopping{false};
+
+    std::shared_ptr<Job> _pop(); // 需持有 mMutex
+    void                 _pump();
+
+public:
+    LD_DISABLE_COPY_AND_MOVE(JobScheduler);
+    LDAPI explicit JobScheduler(ll::thread::ThreadPoolExecutor& pool, size_t concurrency);
+
+    /**
+     * @brief 取消所有尚未开始的任务，并等待运行中的任务结束
+     */
+    LDAPI ~JobScheduler();
+
+    /**
+     * @brief 提交任务
+     * @return 任务句柄；队列已满或调度器正在关闭时返回错误
+     */
+    LDNDAPI ll::Expected<Handle> submit(std::string name, std::function<void()> fn, Options options);
+
+    [[nodiscard]] ll::Expected<Handle>
+    submit(std::string name, std::function<void()> fn, Priority priority = Priority::Normal) {
+        return submit(std::move(name), std::move(fn), Options{.priority = priority});
+    }
+
+    LDNDAPI size_t getConcurrency() const;
+
+    /**
+     * @brief 各优先级的队列深度与运行统计
+     */
+    LDNDAPI std::array<Stats, PriorityCount> getStats() const;
+};
+
+
+} // namespace land
@@ -0,0 +1,143 @@
+#include "pland/infra/PlayerNameCache.h"
+#include "pland/PLand.h"
+#include "pland/infra/JobScheduler.h"
+
+#include "ll/api/event/EventBus.h"
+#include "ll/api/event/player/PlayerJoinEvent.h"
+#include "ll/api/service/PlayerInfo.h"
+
+#include "mc/world/actor/player/Player.h"
+
+#include <algorithm>
+
+namespace land {
+
+
+PlayerNameCache::PlayerNameCache(size_t capacity) : mCapacity(std::max<size_t>(capacity, 1)) {
+    mPlayerJoinListener = ll::event::EventBus::getInstance().emplaceListener<ll::event::PlayerJoinEvent>(
+        [this](ll::event::PlayerJoinEvent& ev) {
+            auto& player = ev.self();
+            if (player.isSimulatedPlayer()) {
+                return;
+            }
+            update(player.getUuid(), player.getRealName());
+        }
+    );
+}
+
+PlayerNameCache::~PlayerNameCache() { ll::event::EventBus::getInstance().removeListener(mPlayerJoinListener); }
+
+std::string PlayerNameCache::_lookup(mce::UUID const& uuid) {
+    auto info = ll::service::PlayerInfo::getInstance().fromUuid(uuid);
+    return info.has_value() ? info->name : uuid.asString();
+}
+
+std::optional<std::string> PlayerNameCache::_get(mce::UUID const& uuid) {
+    auto iter = mIndex.find(uuid);
+    if (iter == mIndex.end()) {
+        return std::nullopt;
+    }
+    mEntries.splice(mEntries.begin(), mEntries, iter->second);
+    return iter->second->second;
+}
+
+void PlayerNameCache::_put(mce::UUID const& uuid, std::string name) {
+    if (auto iter = mIndex.find(uuid); iter != mIndex.end()) {
+        iter->second->second = std::move(name);
+        mEntries.splice(mEntries.begin(), mEntries, iter->second);
+        return;
+    }
+    mEntries.emplace_front(uuid, std::move(name));
+    mIndex.emplace(uuid, mEntries.begin());
+    if (mEntries.size() > mCapacity) {
+        mIndex.erase(mEntries.back().first); // 淘汰最久未使用的条目
+        mEntries.pop_back();
+    }
+}
+
+std::string PlayerNameCache::resolve(mce::UUID const& uuid) {
+    {
+        std::lock_guard lock(mMutex);
+        if (auto name = _get(uuid)) {
+            return std::move(*name);
+        }
+    }
+    auto name = _lookup(uuid); // 查询期间不持锁
+    std::lock_guard lock(mMutex);
+    _put(uuid, name);
+    return name;
+}
+
+std::vector<std::string> PlayerNameCache::resolve(std::span<mce::UUID const> uuids) {
+    std::vector<std::string> result(uuids.size());
+    std::vector<size_t>      misses;
+    {
+        std::lock_guard lock(mMutex);
+        for (size_t i = 0; i < uuids.size(); ++i) {
+            if (auto name = _get(uuids[i])) {
+                result[i] = std::move(*name);
+            } else {
+                misses.push_back(i);
+            }
+        }
+    }
+    if (misses.empty()) {
+        return result;
+    }
+
+    for (auto i : misses) {
+        result[i] = _lookup(uuids[i]);
+    }
+    std::lock_guard lock(mMutex);
+    for (auto i : misses) {
+        _put(uuids[i], result[i]);
+    }
+    return result;
+}
+
+std::optional<std::string> PlayerNameCache::tryGet(mce::UUID const& uuid) const {
+    std::lock_guard lock(mMutex);
+    if (auto iter = mIndex.find(uuid); iter != mIndex.end()) {
+        return iter->second->second;
+    }
+    return std::nullopt;
+}
+
+void PlayerNameCache::prefetch(std::vector<mce::UUID> uuids) {
+    {
+        std::lock_guard lock(mMutex);
+        std::erase_if(uuids, [this](mce::UUID const& uuid) { return mIndex.contains(uuid); });
+    }
+    if (uuids.size() > mCapacity) {
+        uuids.resize(mCapacity); // 超出容量的部分写入后也会被立即淘汰
+    }
+    if (uuids.empty()) {
+        return;
+    }
+
+    auto scheduler = PLand::getInstance().getJobScheduler();
+    if (!scheduler) {
+        return; // 调度器不可用(插件关闭中)，使用时再同步查询
+    }
+    auto handle = scheduler->submit(
+        "player-name-prefetch",
+        [this, uuids = std::move(uuids)]() { (void)resolve(uuids); },
+        JobScheduler::Priority::Low
+    );
+    if (!handle) {
+        PLand::getInstance().getSelf().getLogger().debug("Skip player name prefetch: {}", handle.error().message());
+    }
+}
+
+void PlayerNameCache::update(mce::UUID const& uuid, std::string name) {
+    std::lock_guard lock(mMutex);
+    _put(uuid, std::move(name));
+}
+
+size_t PlayerNameCache::size() const {
+    std::lock_guard lock(mMutex);
+    return mEntries.size();
+}
+
+
+} // namespace land
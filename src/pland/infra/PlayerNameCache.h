@@ -0,0 +1,78 @@
+#pragma once
+#include "pland/Global.h"
+
+#include "ll/api/event/ListenerBase.h"
+
+#include "mc/platform/UUID.h"
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace land {
+
+
+/**
+ * @brief 玩家名缓存(UUID -> 显示名称)
+ *
+ * 领地提示、管理 GUI 与开发工具共用，避免对同一批领地主人反复调用 PlayerInfo::fromUuid。
+ * 容量有限，超出时淘汰最久未使用的条目；玩家进服时更新其名称。
+ * 未知玩家缓存为 UUID 字符串，玩家进服后被真实名称覆盖。
+ *
+ * @note 线程安全
+ */
+class PlayerNameCache final {
+    using Entry = std::pair<mce::UUID, std::string>;
+
+    size_t const                                              mCapacity;
+    mutable std::mutex                                        mMutex;
+    std::list<Entry>                                          mEntries; // 按最近使用排序，表头最新
+    std::unordered_map<mce::UUID, std::list<Entry>::iterator> mIndex;
+    ll::event::ListenerPtr                                    mPlayerJoinListener{nullptr};
+
+    static std::string _lookup(mce::UUID const& uuid); // 查询 PlayerInfo，不加锁
+
+    std::optional<std::string> _get(mce::UUID const& uuid);                   // 需持有 mMutex，命中时移到表头
+    void                       _put(mce::UUID const& uuid, std::string name); // 需持有 mMutex
+
+public:
+    static constexpr size_t DefaultCapacity = 4096;
+
+    LD_DISABLE_COPY_AND_MOVE(PlayerNameCache);
+    LDAPI explicit PlayerNameCache(size_t capacity = DefaultCapacity);
+    LDAPI ~PlayerNameCache();
+
+    /**
+     * @brief 获取玩家名，未命中时同步查询并写入缓存
+     */
+    LDNDAPI std::string resolve(mce::UUID const& uuid);
+
+    /**
+     * @brief 批量获取玩家名，结果与 uuids 一一对应
+     * @note 命中部分在同一把锁内读取，未命中部分统一查询后一次写入
+     */
+    LDNDAPI std::vector<std::string> resolve(std::span<mce::UUID const> uuids);
+
+    /**
+     * @brief 仅查询缓存，不触发查询
+     */
+    LDNDAPI std::optional<std::string> tryGet(mce::UUID const& uuid) const;
+
+    /**
+     * @brief 在后台任务中解析尚未缓存的玩家名(最多 mCapacity 个)
+     */
+    LDAPI void prefetch(std::vector<mce::UUID> uuids);
+
+    LDAPI void update(mce::UUID const& uuid, std::string name);
+
+    LDNDAPI size_t size() const;
+};
+
+
+} // namespace land
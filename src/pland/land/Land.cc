@@ -4,11 +4,13 @@
 #include "mc/platform/UUID.h"
 #include "pland/Global.h"
 #include "pland/PLand.h"
+#include "pland/economy/PriceCalculate.h"
 #include "pland/infra/Config.h"
 #include "pland/land/LandRegistry.h"
 #include "pland/utils/JsonUtil.h"
 #include <stack>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 
@@ -111,6 +113,7 @@ std::string const& Land::getName() const { return mContext.mLandName; }
 void               Land::setName(std::string const& name) {
     mContext.mLandName = name;
     mDirtyCounter.increment();
+    PLand::getInstance().getLandRegistry().refreshLandName(*this);
 }
 
 std::string const& Land::getDescribe() const { return mContext.mLandDescribe; }
@@ -328,6 +331,26 @@ bool Land::operator==(SharedLand const& other) const { return mContext.mLandID =
 
 // static
 llong Land::calculatePriceRecursively(SharedLand const& land, RecursionCalculationPriceHandle const& handle) {
+    if (!handle) {
+        // 展开为父下标数组，与批量计价共用子树汇总
+        std::vector<double>                    prices;
+        std::vector<int>                       parents;
+        std::stack<std::pair<SharedLand, int>> stack; // (领地, 父领地下标)
+        stack.emplace(land, -1);
+        while (!stack.empty()) {
+            auto [current, parent] = std::move(stack.top());
+            stack.pop();
+
+            auto index = static_cast<int>(prices.size());
+            prices.push_back(static_cast<double>(current->mContext.mOriginalBuyPrice));
+            parents.push_back(parent);
+            for (auto& subLand : current->getSubLands()) {
+                stack.emplace(subLand, index);
+            }
+        }
+        return static_cast<llong>(PriceCalculate::sumSubtrees(prices, parents)[0]);
+    }
+
     std::stack<SharedLand> stack;
     stack.push(land);
 
@@ -337,11 +360,7 @@ llong Land::calculatePriceRecursively(SharedLand const& land, RecursionCalculati
         SharedLand current = stack.top();
         stack.pop();
 
-        if (handle) {
-            if (!handle(current, price)) break; // if handle return false, break
-        } else {
-            price += current->mContext.mOriginalBuyPrice;
-        }
+        if (!handle(current, price)) break; // if handle return false, break
 
         if (current->hasSubLand()) {
             for (auto& subLand : current->getSubLands()) {
@@ -0,0 +1,34 @@
+#include "LandBatch.h"
+
+#include <utility>
+
+namespace land {
+
+LandBatch::LandBatch() = default;
+
+LandBatch& LandBatch::addOrdinaryLand(SharedLand land) {
+    mOperations.push_back({OpType::AddOrdinaryLand, std::move(land)});
+    return *this;
+}
+
+LandBatch& LandBatch::removeOrdinaryLand(SharedLand land) {
+    mOperations.push_back({OpType::RemoveOrdinaryLand, std::move(land)});
+    return *this;
+}
+
+LandBatch& LandBatch::setOwner(SharedLand land, mce::UUID const& owner) {
+    mOperations.push_back({OpType::SetOwner, std::move(land), owner});
+    return *this;
+}
+
+void LandBatch::reserve(size_t count) { mOperations.reserve(count); }
+
+void LandBatch::clear() { mOperations.clear(); }
+
+bool LandBatch::empty() const { return mOperations.empty(); }
+
+size_t LandBatch::size() const { return mOperations.size(); }
+
+std::vector<LandBatch::Operation> const& LandBatch::getOperations() const { return mOperations; }
+
+} // namespace land
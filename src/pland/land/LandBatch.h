@@ -0,0 +1,57 @@
+#pragma once
+#include "pland/Global.h"
+#include "pland/land/Land.h"
+
+#include "mc/platform/UUID.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace land {
+
+
+/**
+ * @brief 领地批量操作
+ *
+ * 收集一组操作后交由 LandRegistry::commit() 一次性校验并提交，
+ * 任一操作失败则整批回滚，其他线程不会观察到中间状态。
+ */
+class LandBatch {
+public:
+    enum class OpType {
+        AddOrdinaryLand,    // 添加普通领地
+        RemoveOrdinaryLand, // 移除普通领地
+        SetOwner,           // 变更领地主人
+    };
+
+    struct Operation {
+        OpType     type;
+        SharedLand land;
+        mce::UUID  owner{}; // 仅 SetOwner
+    };
+
+private:
+    std::vector<Operation> mOperations;
+
+public:
+    LDAPI explicit LandBatch();
+
+    LDAPI LandBatch& addOrdinaryLand(SharedLand land);
+
+    LDAPI LandBatch& removeOrdinaryLand(SharedLand land);
+
+    LDAPI LandBatch& setOwner(SharedLand land, mce::UUID const& owner);
+
+    LDAPI void reserve(size_t count);
+
+    LDAPI void clear();
+
+    LDNDAPI bool empty() const;
+
+    LDNDAPI size_t size() const;
+
+    LDNDAPI std::vector<Operation> const& getOperations() const;
+};
+
+
+} // namespace land
@@ -137,17 +137,21 @@ ll::Expected<> LandCreateValidator::isLandRangeConflict(
     SharedLand const&       land,
     std::optional<LandAABB> newRange
 ) {
-    auto&       aabb       = newRange ? *newRange : land->getAABB();
-    auto const& minSpacing = Config::cfg.land.minSpacing;
-    auto        expanded   = aabb.expanded(minSpacing, Config::cfg.land.minSpacingIncludeY);
-    auto        lands      = registry.getLandAt(expanded.min.as(), expanded.max.as(), land->getDimensionId());
-    if (lands.empty()) {
-        return {};
-    }
+    auto& aabb     = newRange ? *newRange : land->getAABB();
+    auto  expanded = aabb.expanded(Config::cfg.land.minSpacing, Config::cfg.land.minSpacingIncludeY);
+    auto  lands    = registry.getLandsIntersecting(expanded, land->getDimensionId());
+    return isRangeConflictWith(aabb, lands, newRange ? land : SharedLand{}); // 仅在更改范围时排除自己
+}
 
-    for (auto& ld : lands) {
-        if (newRange && ld == land) {
-            continue; // 仅在更改范围时排除自己
+ll::Expected<> LandCreateValidator::isRangeConflictWith(
+    LandAABB const&                aabb,
+    std::vector<SharedLand> const& candidates,
+    SharedLand const&              self
+) {
+    auto const& minSpacing = Config::cfg.land.minSpacing;
+    for (auto& ld : candidates) {
+        if (self && ld == self) {
+            continue;
         }
 
         if (LandAABB::isCollision(ld->getAABB(), aabb)) {
@@ -163,6 +167,14 @@ ll::Expected<> LandCreateValidator::isLandRangeConflict(
 }
 
 ll::Expected<> LandCreateValidator::isSubLandPositionLegal(SharedLand const& land, LandAABB const& subRange) {
+    return isSubLandPositionLegal(PLand::getInstance().getLandRegistry(), land, subRange);
+}
+
+ll::Expected<> LandCreateValidator::isSubLandPositionLegal(
+    LandRegistry&     registry,
+    SharedLand const& land,
+    LandAABB const&   subRange
+) {
     // 子领地必须位于父领地内
     if (!LandAABB::isContain(land->getAABB(), subRange)) {
         return makeError<SubLandNotInParent>(land, subRange);
@@ -172,8 +184,8 @@ ll::Expected<> LandCreateValidator::isSubLandPositionLegal(SharedLand const& lan
     bool const  includeY   = Config::cfg.land.subLand.minSpacingIncludeY;
     auto        expanded   = subRange.expanded(minSpacing, includeY);
 
-    auto family  = land->getFamilyTree();       // 整个领地家族
-    auto parents = land->getSelfAndAncestors(); // 相对于 land 的所有父领地
+    auto family  = registry.getFamilyLandsIntersecting(land, expanded); // 家族内间距范围内的领地
+    auto parents = land->getSelfAndAncestors();                          // 相对于 land 的所有父领地
 
     // 子领地不能与家族内其他领地冲突
     for (auto& member : family) {
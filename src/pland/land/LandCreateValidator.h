@@ -6,6 +6,7 @@
 #include "ll/api/Expected.h"
 
 #include <optional>
+#include <vector>
 
 
 namespace land {
@@ -137,6 +138,14 @@ class LandCreateValidator {
         std::optional<LandAABB> newRange = std::nullopt
     );
 
+    /**
+     * @brief 范围与候选领地是否冲突或间距过小
+     * @param candidates 候选领地(通常为按最小间距扩展后的范围查询结果)
+     * @param self 需要排除的领地，可为空
+     */
+    LDNDAPI static ll::Expected<>
+    isRangeConflictWith(LandAABB const& aabb, std::vector<SharedLand> const& candidates, SharedLand const& self = {});
+
     /**
      * @brief 验证子领地位置是否合法(相对于父领地)
      * @param land 父领地 (相对于 sub 的父领地)
@@ -147,6 +156,9 @@ class LandCreateValidator {
      * @note 3. 子领地与其它家族成员的距离不能小于最小间距要求。
      */
     LDNDAPI static ll::Expected<> isSubLandPositionLegal(SharedLand const& land, LandAABB const& subRange);
+
+    LDNDAPI static ll::Expected<>
+    isSubLandPositionLegal(LandRegistry& registry, SharedLand const& land, LandAABB const& subRange);
 };
 
 
@@ -0,0 +1,340 @@
+#include "LandNameIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace land {
+
+namespace {
+
+/**
+ * @brief 从 first 开始指数步进后二分，查找第一个不小于 id 的位置(目标通常就在游标附近)
+ */
+std::vector<LandID>::const_iterator
+gallop(std::vector<LandID>::const_iterator first, std::vector<LandID>::const_iterator last, LandID id) {
+    ptrdiff_t step = 1;
+    auto      low  = first;
+    while (low != last && *low < id) {
+        first = low;
+        if (last - low <= step) {
+            low = last;
+            break;
+        }
+        low  += step;
+        step *= 2;
+    }
+    return std::lower_bound(first, low, id);
+}
+
+} // namespace
+
+std::string LandNameIndex::_normalize(std::string_view name) {
+    std::string result(name);
+    for (auto& c : result) {
+        if (static_cast<unsigned char>(c) < 0x80) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
+    return result;
+}
+
+std::vector<LandNameIndex::Trigram> LandNameIndex::_trigrams(std::string_view name) {
+    std::vector<Trigram> result;
+    if (name.size() < 3) {
+        return result;
+    }
+    result.reserve(name.size() - 2);
+    for (size_t i = 0; i + 2 < name.size(); ++i) {
+        result.push_back(
+            static_cast<Trigram>(static_cast<unsigned char>(name[i])) << 16
+            | static_cast<Trigram>(static_cast<unsigned char>(name[i + 1])) << 8
+            | static_cast<Trigram>(static_cast<unsigned char>(name[i + 2]))
+        );
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void LandNameIndex::_erasePostings(LandID id, std::string const& name) {
+    for (auto trigram : _trigrams(name)) {
+        auto iter = mPostings.find(trigram);
+        if (iter == mPostings.end()) {
+            continue;
+        }
+        auto& ids = iter->second;
+        if (auto pos = std::lower_bound(ids.begin(), ids.end(), id); pos != ids.end() && *pos == id) {
+            ids.erase(pos);
+        }
+        if (ids.empty()) {
+            mPostings.erase(iter);
+        }
+    }
+}
+
+float LandNameIndex::_score(std::string const& name, std::string const& keyword, float similarity) {
+    auto score = similarity;
+    if (name == keyword) {
+        score += 3.0f;
+    } else if (name.starts_with(keyword)) {
+        score += 2.0f;
+    } else if (name.find(keyword) != std::string::npos) {
+        score += 1.0f;
+    }
+    // 相关度相同时名称越短越靠前
+    return score - static_cast<float>(name.size()) * 1e-4f;
+}
+
+void LandNameIndex::insert(LandID id, std::string_view name) {
+    Entry entry{id, name};
+    insert({&entry, 1});
+}
+
+void LandNameIndex::insert(std::span<Entry const> entries) {
+    // 同一ID只保留最后一次
+    std::unordered_map<LandID, std::string> pending;
+    pending.reserve(entries.size());
+    for (auto const& [id, name] : entries) {
+        pending.insert_or_assign(id, _normalize(name));
+    }
+
+    // 先移除旧名称的倒排记录，此时所有倒排表仍有序
+    std::erase_if(pending, [this](auto const& entry) {
+        auto iter = mNames.find(entry.first);
+        if (iter == mNames.end()) {
+            return false;
+        }
+        if (iter->second == entry.second) {
+            return true; // 名称未变化
+        }
+        _erasePostings(entry.first, iter->second);
+        return false;
+    });
+    if (pending.empty()) {
+        return;
+    }
+    ++mVersion;
+
+    std::unordered_map<Trigram, size_t> sortedSizes; // 三元组 -> 追加前的倒排表长度
+    for (auto& [id, normalized] : pending) {
+        for (auto trigram : _trigrams(normalized)) {
+            auto& ids = mPostings[trigram];
+            sortedSizes.try_emplace(trigram, ids.size());
+            ids.push_back(id);
+        }
+        mNames[id] = std::move(normalized);
+    }
+    for (auto const& [trigram, sortedSize] : sortedSizes) {
+        auto& ids    = mPostings[trigram];
+        auto  middle = ids.begin() + static_cast<ptrdiff_t>(sortedSize);
+        std::sort(middle, ids.end());
+        std::inplace_merge(ids.begin(), middle, ids.end());
+    }
+}
+
+void LandNameIndex::erase(LandID id) {
+    auto iter = mNames.find(id);
+    if (iter == mNames.end()) {
+        return;
+    }
+    _erasePostings(id, iter->second);
+    mNames.erase(iter);
+    ++mVersion;
+}
+
+void LandNameIndex::clear() {
+    mNames.clear();
+    mPostings.clear();
+    ++mVersion;
+}
+
+bool LandNameIndex::contains(LandID id) const { return mNames.contains(id); }
+
+size_t LandNameIndex::size() const { return mNames.size(); }
+
+uint64_t LandNameIndex::version() const { return mVersion; }
+
+std::vector<LandID> LandNameIndex::search(std::string_view keyword) const {
+    std::vector<LandID> result;
+    if (keyword.empty()) {
+        return result;
+    }
+    auto normalized = _normalize(keyword);
+
+    auto trigrams = _trigrams(normalized);
+    if (trigrams.empty()) {
+        for (auto const& [id, name] : mNames) { // 关键字过短，遍历名称
+            if (name.find(normalized) != std::string::npos) {
+                result.push_back(id);
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // 从最短的倒排表开始求交集
+    std::vector<std::vector<LandID> const*> postings;
+    postings.reserve(trigrams.size());
+    for (auto trigram : trigrams) {
+        auto iter = mPostings.find(trigram);
+        if (iter == mPostings.end()) {
+            return result; // 存在未出现过的三元组，不可能匹配
+        }
+        postings.push_back(&iter->second);
+    }
+    std::sort(postings.begin(), postings.end(), [](auto const* a, auto const* b) { return a->size() < b->size(); });
+
+    for (auto id : *postings.front()) {
+        bool candidate = std::all_of(postings.begin() + 1, postings.end(), [id](auto const* ids) {
+            return std::binary_search(ids->begin(), ids->end(), id);
+        });
+        // 三元组全部命中不代表连续出现(且三元组已去重，"aaaa" 与 "aaa" 的三元组相同)，
+        // 只有关键字恰为一个三元组时才能跳过子串校验
+        if (candidate && (normalized.size() == 3 || mNames.at(id).find(normalized) != std::string::npos)) {
+            result.push_back(id);
+        }
+    }
+    return result;
+}
+
+LandNameIndex::SearchResult LandNameIndex::searchRanked(std::string_view keyword, size_t offset, size_t limit) const {
+    SearchResult result;
+    if (keyword.empty()) {
+        return result;
+    }
+    auto normalized = _normalize(keyword);
+    auto trigrams   = _trigrams(normalized);
+
+    std::vector<Match> matches;
+    if (trigrams.empty()) {
+        for (auto const& [id, name] : mNames) { // 关键字过短，只能按子串匹配
+            if (name.find(normalized) != std::string::npos) {
+                matches.push_back({id, _score(name, normalized, 1.0f)});
+            }
+        }
+    } else {
+        std::vector<std::vector<LandID> const*> postings;
+        postings.reserve(trigrams.size());
+        for (auto trigram : trigrams) {
+            if (auto iter = mPostings.find(trigram); iter != mPostings.end()) {
+                postings.push_back(&iter->second);
+            }
+        }
+        auto const total    = trigrams.size();
+        auto const required = static_cast<size_t>(std::ceil(static_cast<float>(total) * MinSimilarity));
+        if (postings.size() < required) {
+            return result;
+        }
+        std::sort(postings.begin(), postings.end(), [](auto const* a, auto const* b) { return a->size() < b->size(); });
+
+        // 命中 required 个三元组的领地必然出现在最短的 (n - required + 1) 个倒排表之一中，
+        // 候选只从这些表中产生，常见三元组的长倒排表只用于二分校验
+        auto const seedCount = postings.size() - required + 1;
+
+        // 多路归并种子倒排表(均为升序)，同一领地连续出现，无需哈希表计数
+        using Cursor = std::pair<std::vector<LandID>::const_iterator, std::vector<LandID>::const_iterator>;
+        auto greater = [](Cursor const& a, Cursor const& b) { return *a.first > *b.first; };
+        std::vector<Cursor> heap;
+        heap.reserve(seedCount);
+        for (size_t i = 0; i < seedCount; ++i) {
+            heap.emplace_back(postings[i]->begin(), postings[i]->end());
+        }
+        std::make_heap(heap.begin(), heap.end(), greater);
+
+        // 其余倒排表按升序推进游标校验
+        std::vector<std::vector<LandID>::const_iterator> cursors;
+        cursors.reserve(postings.size() - seedCount);
+        for (size_t i = seedCount; i < postings.size(); ++i) {
+            cursors.push_back(postings[i]->begin());
+        }
+
+        while (!heap.empty()) {
+            auto   id    = *heap.front().first;
+            size_t count = 0;
+            while (!heap.empty() && *heap.front().first == id) {
+                ++count;
+                std::pop_heap(heap.begin(), heap.end(), greater);
+                if (++heap.back().first == heap.back().second) {
+                    heap.pop_back();
+                } else {
+                    std::push_heap(heap.begin(), heap.end(), greater);
+                }
+            }
+            for (size_t i = seedCount; i < postings.size(); ++i) {
+                auto& cursor = cursors[i - seedCount];
+                cursor       = gallop(cursor, postings[i]->end(), id);
+                if (cursor != postings[i]->end() && *cursor == id) {
+                    ++count;
+                }
+            }
+            if (count < required) {
+                continue;
+            }
+            auto similarity = static_cast<float>(count) / static_cast<float>(total);
+            matches.push_back({id, _score(mNames.at(id), normalized, similarity)});
+        }
+    }
+
+    result.total = matches.size();
+    if (offset >= matches.size()) {
+        return result;
+    }
+    auto byScore = [](Match const& a, Match const& b) { return a.score != b.score ? a.score > b.score : a.id < b.id; };
+    auto first   = matches.begin() + static_cast<ptrdiff_t>(offset);
+    auto last    = first + static_cast<ptrdiff_t>(std::min(limit, matches.size() - offset));
+    std::partial_sort(matches.begin(), last, matches.end(), byScore);
+    result.matches.assign(first, last);
+    return result;
+}
+
+
+std::vector<LandNameIndex::Match> LandNameIndex::rank(std::string_view keyword, std::span<LandID const> ids) const {
+    std::vector<Match> matches;
+    if (keyword.empty()) {
+        return matches;
+    }
+    auto       normalized = _normalize(keyword);
+    auto       trigrams   = _trigrams(normalized);
+    auto const total      = trigrams.size();
+    auto const required   = static_cast<size_t>(std::ceil(static_cast<float>(total) * MinSimilarity));
+
+    // 候选集合通常远小于索引，逐个比较三元组，无需遍历倒排表
+    for (auto id : ids) {
+        auto iter = mNames.find(id);
+        if (iter == mNames.end()) {
+            continue;
+        }
+        auto const& name = iter->second;
+        if (trigrams.empty()) {
+            if (name.find(normalized) != std::string::npos) {
+                matches.push_back({id, _score(name, normalized, 1.0f)});
+            }
+            continue;
+        }
+        auto   own   = _trigrams(name);
+        size_t count = 0;
+        for (auto a = trigrams.begin(), b = own.begin(); a != trigrams.end() && b != own.end();) {
+            if (*a < *b) {
+                ++a;
+            } else if (*b < *a) {
+                ++b;
+            } else {
+                ++count;
+                ++a;
+                ++b;
+            }
+        }
+        if (count >= required) {
+            matches.push_back({id, _score(name, normalized, static_cast<float>(count) / static_cast<float>(total))});
+        }
+    }
+    std::sort(matches.begin(), matches.end(), [](Match const& a, Match const& b) {
+        return a.score != b.score ? a.score > b.score : a.id < b.id;
+    });
+    return matches;
+}
+
+} // namespace land
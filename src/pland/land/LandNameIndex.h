@@ -0,0 +1,104 @@
+#pragma once
+#include "pland/Global.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace land {
+
+
+/**
+ * @brief 领地名称三元组(trigram)倒排索引
+ *
+ * 按字节切分名称(UTF-8 多字节字符同样适用)，每个三元组记录包含它的领地ID(有序)。
+ * 搜索时对关键字的各三元组求交集得到候选，再校验子串，耗时与候选数量相关而与领地总数无关。
+ * 关键字不足 3 字节时无法使用三元组，退化为遍历名称。匹配忽略 ASCII 大小写。
+ * 模糊搜索按共有三元组比例打分，允许错字/漏字，子串、前缀与完全匹配额外加分。
+ *
+ * @note 非线程安全，需由调用方加锁
+ */
+class LandNameIndex final {
+public:
+    static constexpr float MinSimilarity = 0.5f; // 模糊搜索最低相似度(共有三元组 / 关键字三元组)
+
+    using Entry = std::pair<LandID, std::string_view>;
+
+    struct Match {
+        LandID id;
+        float  score; // 相关度，越大越相关
+    };
+    struct SearchResult {
+        std::vector<Match> matches;  // 当前页结果(按相关度降序)
+        size_t             total{0}; // 分页前的命中总数
+    };
+
+private:
+    using Trigram = uint32_t;
+
+    std::unordered_map<LandID, std::string>          mNames;      // 领地ID -> 小写名称
+    std::unordered_map<Trigram, std::vector<LandID>> mPostings;   // 三元组 -> 领地ID(升序)
+    uint64_t                                         mVersion{0}; // 变更计数
+
+    static std::string          _normalize(std::string_view name);
+    static std::vector<Trigram> _trigrams(std::string_view name); // 去重后的三元组
+
+    void _erasePostings(LandID id, std::string const& name);
+
+    static float _score(std::string const& name, std::string const& keyword, float similarity);
+
+public:
+    LD_DISABLE_COPY_AND_MOVE(LandNameIndex);
+    explicit LandNameIndex() = default;
+
+    /**
+     * @brief 插入或更新领地名称
+     */
+    LDAPI void insert(LandID id, std::string_view name);
+
+    /**
+     * @brief 批量插入或更新，新增ID先追加到倒排表末尾，每个倒排表最后只排序合并一次
+     * @note 同一ID出现多次时以最后一次为准
+     */
+    LDAPI void insert(std::span<Entry const> entries);
+
+    LDAPI void erase(LandID id);
+
+    LDAPI void clear();
+
+    LDNDAPI bool contains(LandID id) const;
+
+    LDNDAPI size_t size() const;
+
+    /**
+     * @brief 变更计数，每次名称增删改后递增，供调用方判断缓存的搜索结果是否过期
+     */
+    LDNDAPI uint64_t version() const;
+
+    /**
+     * @brief 查找名称包含关键字的领地
+     * @return 领地ID(升序)，关键字为空时返回空
+     */
+    LDNDAPI std::vector<LandID> search(std::string_view keyword) const;
+
+    /**
+     * @brief 模糊搜索，按相关度排序后分页
+     * @param offset 跳过的结果数
+     * @param limit  最多返回的结果数
+     */
+    LDNDAPI SearchResult searchRanked(std::string_view keyword, size_t offset, size_t limit) const;
+
+    /**
+     * @brief 只在给定领地中模糊搜索，打分规则与 searchRanked 相同
+     * @return 命中的领地(按相关度降序)，不在索引中的ID被忽略
+     */
+    LDNDAPI std::vector<Match> rank(std::string_view keyword, std::span<LandID const> ids) const;
+};
+
+
+} // namespace land
@@ -0,0 +1,49 @@
+#include "pland/land/LandQuery.h"
+#include "pland/PLand.h"
+
+#include "ll/api/coro/CoroTask.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
+#include "ll/api/thread/ThreadPoolExecutor.h"
+
+#include <exception>
+
+namespace land {
+
+
+LandQuery::Snapshot LandQuery::capture(std::vector<SharedLand> const& lands) {
+    Snapshot snapshot;
+    snapshot.reserve(lands.size());
+    for (auto const& land : lands) {
+        snapshot.push_back({land->getId(), land->getOwner()});
+    }
+    return snapshot;
+}
+
+void LandQuery::_dispatch(std::function<void()> work, std::function<void()> resume) {
+    auto pool = PLand::getInstance().getThreadPool();
+    if (!pool) {
+        work();
+        resume();
+        return;
+    }
+
+    ll::coro::keepThis([work = std::move(work), resume = std::move(resume)]() -> ll::coro::CoroTask<> {
+        try {
+            work();
+        } catch (std::exception const& e) {
+            PLand::getInstance().getSelf().getLogger().error(
+                "An exception occurred while running land query: {}",
+                e.what()
+            );
+            co_return;
+        } catch (...) {
+            PLand::getInstance().getSelf().getLogger().error("An unknown exception occurred while running land query");
+            co_return;
+        }
+        ll::thread::ServerThreadExecutor::getDefault().execute(std::move(resume));
+        co_return;
+    }).launch(*pool);
+}
+
+
+} // namespace land
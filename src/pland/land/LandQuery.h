@@ -0,0 +1,85 @@
+#pragma once
+#include "pland/Global.h"
+#include "pland/land/Land.h"
+
+#include "mc/deps/ecs/WeakEntityRef.h"
+#include "mc/platform/UUID.h"
+#include "mc/world/actor/player/Player.h"
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace land {
+
+
+/**
+ * @brief 异步领地查询
+ *
+ * 在服务器线程上复制领地的只读字段作为快照，筛选/排序等耗时部分在 PLand 线程池中执行，
+ * 完成后回到服务器线程交付结果，大量领地的管理列表不再占用游戏刻。
+ * 线程池不可用时(如插件关闭过程中)同步执行。
+ *
+ * @note 查询函数运行在线程池中，只能读取快照，不得访问领地对象或调用游戏 API；
+ *       需要领地对象时返回领地ID，在服务器线程中重新获取
+ */
+class LandQuery final {
+public:
+    struct Entry {
+        LandID    id;
+        mce::UUID owner;
+    };
+    using Snapshot = std::vector<Entry>;
+
+    template <typename T>
+    using Query = std::function<T(Snapshot)>;
+
+    LandQuery() = delete;
+
+    /**
+     * @brief 复制领地字段生成快照
+     * @note 需在服务器线程调用
+     */
+    LDNDAPI static Snapshot capture(std::vector<SharedLand> const& lands);
+
+    /**
+     * @brief 执行查询
+     * @param snapshot 领地快照(在服务器线程通过 capture 获取)
+     * @param query    在线程池中执行的查询
+     * @param resume   在服务器线程中接收结果
+     */
+    template <typename T>
+    static void run(Snapshot snapshot, Query<T> query, std::function<void(T)> resume) {
+        auto result = std::make_shared<std::optional<T>>();
+        _dispatch(
+            [result, snapshot = std::move(snapshot), query = std::move(query)]() mutable {
+                result->emplace(query(std::move(snapshot)));
+            },
+            [result, resume = std::move(resume)]() { resume(std::move(**result)); }
+        );
+    }
+
+    /**
+     * @brief 为玩家执行查询，玩家在查询完成前离线则丢弃结果
+     */
+    template <typename T>
+    static void runFor(Player& player, Snapshot snapshot, Query<T> query, std::function<void(Player&, T)> resume) {
+        run<T>(
+            std::move(snapshot),
+            std::move(query),
+            [weak = player.getWeakEntity(), resume = std::move(resume)](T result) {
+                if (Player* player = weak.tryUnwrap<Player>()) {
+                    resume(*player, std::move(result));
+                }
+            }
+        );
+    }
+
+private:
+    LDAPI static void _dispatch(std::function<void()> work, std::function<void()> resume);
+};
+
+
+} // namespace land
@@ -4,14 +4,18 @@
 #include "pland/Global.h"
 #include "pland/PLand.h"
 #include "pland/aabb/LandAABB.h"
+#include "pland/drawer/DrawHandleManager.h"
+#include "pland/infra/Config.h"
 #include "pland/land/Land.h"
 #include "pland/land/LandContext.h"
 #include "pland/land/LandTemplatePermTable.h"
 #include "pland/utils/JsonUtil.h"
 
 #include "ll/api/Expected.h"
+#include "ll/api/coro/CoroTask.h"
 #include "ll/api/data/KeyValueDB.h"
 #include "ll/api/i18n/I18n.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
 
 #include "mc/platform/UUID.h"
 #include "mc/world/actor/player/Player.h"
@@ -26,6 +30,7 @@
 #include <filesystem>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <stdexcept>
 #include <string>
@@ -212,23 +217,268 @@ void LandRegistry::_loadLandTemplatePermTable() {
 }
 
 void LandRegistry::_buildDimensionChunkMap() {
+    std::vector<SharedLand> lands;
+    lands.reserve(mLandCache.size());
     for (auto& [id, land] : mLandCache) {
-        mDimensionChunkMap.addLand(land);
+        lands.push_back(land);
+    }
+    _indexLands(lands);
+}
+
+LandRegistry::DimensionShard& LandRegistry::_shardOf(LandDimid dimid) {
+    return mShards[static_cast<size_t>(static_cast<uint32_t>(dimid)) % DimensionShardCount];
+}
+LandRegistry::DimensionShard const& LandRegistry::_shardOf(LandDimid dimid) const {
+    return mShards[static_cast<size_t>(static_cast<uint32_t>(dimid)) % DimensionShardCount];
+}
+
+std::vector<std::unique_lock<std::shared_mutex>> LandRegistry::_lockShards(std::span<SharedLand const> lands) {
+    std::array<bool, DimensionShardCount> used{};
+    for (auto const& land : lands) {
+        used[static_cast<size_t>(&_shardOf(land->getDimensionId()) - mShards.data())] = true;
+    }
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+    for (size_t i = 0; i < DimensionShardCount; ++i) {
+        if (used[i]) {
+            locks.emplace_back(mShards[i].mutex);
+        }
+    }
+    return locks;
+}
+
+void LandRegistry::_indexLand(SharedLand const& land) { _indexLands({&land, 1}); }
+
+void LandRegistry::_unindexLand(SharedLand const& land) { _unindexLands({&land, 1}); }
+
+void LandRegistry::_indexLands(std::span<SharedLand const> lands) {
+    if (lands.empty()) {
+        return;
+    }
+    {
+        auto locks = _lockShards(lands);
+        for (auto const& land : lands) {
+            auto& shard = _shardOf(land->getDimensionId());
+            shard.chunkMap.addLand(land);
+            shard.spatialIndex[land->getDimensionId()].insert(land->getId(), land->getAABB());
+            shard.lands[land->getId()] = {land, land->mContext.mParentLandID};
+        }
+        _touchLayout();
+    }
+    {
+        std::vector<LandNameIndex::Entry> names;
+        names.reserve(lands.size());
+        for (auto const& land : lands) {
+            names.emplace_back(land->getId(), land->getName());
+        }
+        std::unique_lock lock(mNameMutex);
+        mNameIndex.insert(names); // 批量插入，加载时每个倒排表只排序一次
+    }
+    for (auto const& land : lands) {
+        _indexFamilyMember(land);
+    }
+}
+
+void LandRegistry::_unindexLands(std::span<SharedLand const> lands) {
+    if (lands.empty()) {
+        return;
+    }
+    {
+        auto locks = _lockShards(lands);
+        for (auto const& land : lands) {
+            auto& shard = _shardOf(land->getDimensionId());
+            shard.chunkMap.removeLand(land);
+            if (auto iter = shard.spatialIndex.find(land->getDimensionId()); iter != shard.spatialIndex.end()) {
+                iter->second.erase(land->getId());
+            }
+            shard.lands.erase(land->getId());
+        }
+        _touchLayout();
+    }
+    {
+        std::unique_lock lock(mNameMutex);
+        for (auto const& land : lands) {
+            mNameIndex.erase(land->getId());
+        }
+    }
+    for (auto const& land : lands) {
+        _unindexFamilyMember(land->getId());
+    }
+}
+
+void LandRegistry::_syncParents(std::span<SharedLand const> lands) {
+    if (lands.empty()) {
+        return;
+    }
+    auto locks = _lockShards(lands);
+    for (auto const& land : lands) {
+        auto& shard = _shardOf(land->getDimensionId());
+        if (auto iter = shard.lands.find(land->getId()); iter != shard.lands.end()) {
+            iter->second.parent = land->mContext.mParentLandID;
+        }
+    }
+    _touchLayout();
+}
+
+void LandRegistry::_indexFamilyMember(SharedLand const& land) {
+    static constexpr auto invalidID = LandID(-1);
+
+    auto rootId = land->mContext.mParentLandID;
+    if (rootId == invalidID) {
+        return; // 根领地本身不进入家族索引
+    }
+    // 沿父领地链找到根领地(嵌套层级有限)
+    for (auto iter = mLandCache.find(rootId); iter != mLandCache.end(); iter = mLandCache.find(rootId)) {
+        auto parentId = iter->second->mContext.mParentLandID;
+        if (parentId == invalidID) {
+            break;
+        }
+        rootId = parentId;
+    }
+    mFamilyRoot[land->getId()] = rootId;
+    mFamilyIndex[rootId].insert(land->getId(), land->getAABB());
+}
+
+void LandRegistry::_unindexFamilyMember(LandID id) {
+    auto rootIter = mFamilyRoot.find(id);
+    if (rootIter == mFamilyRoot.end()) {
+        return;
+    }
+    if (auto iter = mFamilyIndex.find(rootIter->second); iter != mFamilyIndex.end()) {
+        iter->second.erase(id);
+        if (iter->second.size() == 0) {
+            mFamilyIndex.erase(iter);
+        }
+    }
+    mFamilyRoot.erase(rootIter);
+}
+
+void LandRegistry::_reindexFamily(LandID rootId) {
+    std::vector<SharedLand> members;
+    for (auto const& [id, root] : mFamilyRoot) {
+        if (root != rootId) {
+            continue;
+        }
+        if (auto iter = mLandCache.find(id); iter != mLandCache.end()) {
+            members.push_back(iter->second);
+        }
+    }
+    std::erase_if(mFamilyRoot, [rootId](auto const& entry) { return entry.second == rootId; });
+    mFamilyIndex.erase(rootId);
+    for (auto& member : members) {
+        _indexFamilyMember(member);
     }
+    _touchLayout();
 }
 
+void LandRegistry::_touchLayout() { mLayoutEpoch.store(LandSectionCache::nextEpoch(), std::memory_order_release); }
+
 LandID LandRegistry::getNextLandID() const { return mLandIdAllocator->nextId(); }
 
+ll::Expected<> LandRegistry::_validateBatch(LandBatch const& batch) const {
+    using OpType = LandBatch::OpType;
+
+    std::unordered_set<Land const*> added;   // 本批次添加的领地
+    std::unordered_set<LandID>      removed; // 本批次移除的领地
+    std::vector<SharedLand>         adds;
+    for (auto const& op : batch.getOperations()) {
+        if (!op.land) {
+            return StorageError::make(StorageError::ErrorCode::InvalidLand, "The land is null");
+        }
+        auto cached = mLandCache.find(op.land->getId());
+        bool exists = cached != mLandCache.end() && cached->second == op.land && !removed.contains(op.land->getId());
+
+        switch (op.type) {
+        case OpType::AddOrdinaryLand: {
+            if (op.land->getId() != static_cast<LandID>(-1) || !added.insert(op.land.get()).second) {
+                return StorageError::make(
+                    StorageError::ErrorCode::InvalidLand,
+                    "The land is invalid or land ID is not -1"
+                );
+            }
+            if (!op.land->isOrdinaryLand()) {
+                return StorageError::make(
+                    StorageError::ErrorCode::LandTypeMismatch,
+                    "The land type does not match the required type"
+                );
+            }
+            auto const& aabb = op.land->getAABB();
+            if (auto res = LandCreateValidator::isLandRangeLegal(aabb, op.land->getDimensionId(), op.land->is3D());
+                !res) {
+                return res;
+            }
+            if (auto res = LandCreateValidator::isLandInForbiddenRange(aabb, op.land->getDimensionId()); !res) {
+                return res;
+            }
+            adds.push_back(op.land);
+            break;
+        }
+        case OpType::RemoveOrdinaryLand: {
+            if (!exists) {
+                return StorageError::make(StorageError::ErrorCode::InvalidLand, "The land does not exist");
+            }
+            if (!op.land->isOrdinaryLand()) {
+                return StorageError::make(
+                    StorageError::ErrorCode::LandTypeMismatch,
+                    "The land type does not match the required type"
+                );
+            }
+            removed.insert(op.land->getId());
+            break;
+        }
+        case OpType::SetOwner: {
+            if (!exists && !added.contains(op.land.get())) {
+                return StorageError::make(StorageError::ErrorCode::InvalidLand, "The land does not exist");
+            }
+            break;
+        }
+        }
+    }
+    if (adds.empty()) {
+        return {};
+    }
+
+    // 与现有领地冲突(排除本批次移除的领地)
+    auto const& minSpacing = Config::cfg.land.minSpacing;
+    bool const  includeY   = Config::cfg.land.minSpacingIncludeY;
+    for (auto const& land : adds) {
+        auto candidates = _queryLands(land->getAABB().expanded(minSpacing, includeY), land->getDimensionId());
+        std::erase_if(candidates, [&](SharedLand const& ld) { return removed.contains(ld->getId()); });
+        if (auto res = LandCreateValidator::isRangeConflictWith(land->getAABB(), candidates); !res) {
+            return res;
+        }
+    }
+
+    // 批次内互相冲突，每个维度只构建一次临时索引
+    std::unordered_map<LandDimid, LandSpatialIndex> batchIndex;
+    for (size_t i = 0; i < adds.size(); ++i) {
+        batchIndex[adds[i]->getDimensionId()].insert(static_cast<LandID>(i), adds[i]->getAABB());
+    }
+    for (auto const& land : adds) {
+        auto& index = batchIndex[land->getDimensionId()];
+        auto  ids   = index.query(land->getAABB().expanded(minSpacing, includeY));
+
+        std::vector<SharedLand> candidates;
+        candidates.reserve(ids.size());
+        for (auto id : ids) {
+            candidates.push_back(adds[static_cast<size_t>(id)]);
+        }
+        if (auto res = LandCreateValidator::isRangeConflictWith(land->getAABB(), candidates, land); !res) {
+            return res;
+        }
+    }
+    return {};
+}
+
 ll::Expected<> LandRegistry::_removeLand(SharedLand const& ptr) {
-    mDimensionChunkMap.removeLand(ptr);
+    _unindexLand(ptr);
     if (!mLandCache.erase(ptr->getId())) {
-        mDimensionChunkMap.addLand(ptr);
+        _indexLand(ptr);
         return StorageError::make(StorageError::ErrorCode::CacheMapError, "Failed to erase land from cache");
     }
 
     if (!this->mDB->del(std::to_string(ptr->getId()))) {
         mLandCache.emplace(ptr->getId(), ptr); // rollback
-        mDimensionChunkMap.addLand(ptr);
+        _indexLand(ptr);
         return StorageError::make(StorageError::ErrorCode::DatabaseError, "Failed to delete land from database");
     }
     return {};
@@ -240,10 +490,14 @@ ll::Expected<> LandRegistry::_removeLand(SharedLand const& ptr) {
 namespace land {
 
 void LandRegistry::save() {
-    std::shared_lock<std::shared_mutex> lock(mMutex); // 获取锁
-    mDB->set(DbOperatorDataKey, json_util::struct2json(mLandOperators).dump());
+    {
+        std::shared_lock<std::shared_mutex> lock(mSettingsMutex);
+        mDB->set(DbOperatorDataKey, json_util::struct2json(mLandOperators).dump());
 
-    mDB->set(DbPlayerSettingDataKey, json_util::struct2json(mPlayerSettings).dump());
+        mDB->set(DbPlayerSettingDataKey, json_util::struct2json(mPlayerSettings).dump());
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mMutex); // 获取锁
 
     if (mLandTemplatePermTable->isDirty()) {
         if (mDB->set(DbTemplatePermKey, json_util::struct2json(mLandTemplatePermTable->get()).dump())) {
@@ -283,43 +537,70 @@ LandRegistry::LandRegistry() {
 
     logger.trace("构建维度区块映射...");
     _buildDimensionChunkMap();
+    _touchLayout();
     logger.info("初始化维度区块映射完成");
 
     lock.unlock();
-    mThread = std::thread([this]() {
-        while (!mThreadQuit) {
-            std::unique_lock<std::mutex> lk(mThreadMutex);
-            if (mThreadCV.wait_for(lk, std::chrono::minutes(2), [this] { return mThreadQuit.load(); })) {
-                break; // 被 stop 唤醒
+
+    // 定时保存：服务器线程上计时，保存本身作为高优先级后台任务执行
+    mSaveQuit  = std::make_shared<std::atomic<bool>>(false);
+    mSaveSleep = std::make_shared<ll::coro::InterruptableSleep>();
+    ll::coro::keepThis([quit = mSaveQuit, sleep = mSaveSleep, this]() -> ll::coro::CoroTask<> {
+        while (!quit->load()) {
+            co_await sleep->sleepFor(std::chrono::minutes(2));
+            if (quit->load()) {
+                break;
+            }
+            if (mSaveJob.valid() && mSaveJob.state() == JobScheduler::JobState::Pending) {
+                continue; // 上一次保存仍在排队
             }
-            lk.unlock();
-            land::PLand::getInstance().getSelf().getLogger().debug("[Thread] Saving land data...");
-            this->save();
-            land::PLand::getInstance().getSelf().getLogger().debug("[Thread] Land data saved.");
+            auto scheduler = PLand::getInstance().getJobScheduler();
+            if (!scheduler) {
+                continue;
+            }
+            auto job = scheduler->submit(
+                "LandRegistry::save",
+                [this]() {
+                    land::PLand::getInstance().getSelf().getLogger().debug("[Job] Saving land data...");
+                    this->save();
+                    land::PLand::getInstance().getSelf().getLogger().debug("[Job] Land data saved.");
+                },
+                JobScheduler::Priority::High
+            );
+            if (!job) {
+                land::PLand::getInstance().getSelf().getLogger().warn(
+                    "Failed to schedule land data saving: {}",
+                    job.error().message()
+                );
+                continue;
+            }
+            mSaveJob = std::move(*job);
         }
-    });
+        co_return;
+    }).launch(ll::thread::ServerThreadExecutor::getDefault());
 }
 
 LandRegistry::~LandRegistry() {
-    mThreadQuit = true;
-    mThreadCV.notify_all(); // 唤醒线程
-    if (mThread.joinable()) mThread.join();
+    mSaveQuit->store(true);
+    mSaveSleep->interrupt(true);
+    mSaveJob.cancel();
+    mSaveJob.wait(); // 等待正在执行的保存任务结束
 }
 
 bool LandRegistry::isOperator(mce::UUID const& uuid) const {
-    std::shared_lock<std::shared_mutex> lock(mMutex);
+    std::shared_lock<std::shared_mutex> lock(mSettingsMutex);
     return std::find(mLandOperators.begin(), mLandOperators.end(), uuid) != mLandOperators.end();
 }
 bool LandRegistry::addOperator(mce::UUID const& uuid) {
     if (isOperator(uuid)) {
         return false;
     }
-    std::unique_lock<std::shared_mutex> lock(mMutex); // 获取锁
+    std::unique_lock<std::shared_mutex> lock(mSettingsMutex); // 获取锁
     mLandOperators.push_back(uuid);
     return true;
 }
 bool LandRegistry::removeOperator(mce::UUID const& uuid) {
-    std::unique_lock<std::shared_mutex> lock(mMutex); // 获取锁
+    std::unique_lock<std::shared_mutex> lock(mSettingsMutex); // 获取锁
 
     auto iter = std::find(mLandOperators.begin(), mLandOperators.end(), uuid);
     if (iter == mLandOperators.end()) {
@@ -329,13 +610,13 @@ bool LandRegistry::removeOperator(mce::UUID const& uuid) {
     return true;
 }
 std::vector<mce::UUID> const& LandRegistry::getOperators() const {
-    std::shared_lock<std::shared_mutex> lock(mMutex);
+    std::shared_lock<std::shared_mutex> lock(mSettingsMutex);
     return mLandOperators;
 }
 
 
 PlayerSettings* LandRegistry::getPlayerSettings(mce::UUID const& uuid) {
-    std::shared_lock<std::shared_mutex> lock(mMutex);
+    std::shared_lock<std::shared_mutex> lock(mSettingsMutex);
     auto                                iter = mPlayerSettings.find(uuid);
     if (iter == mPlayerSettings.end()) {
         return nullptr;
@@ -343,12 +624,12 @@ PlayerSettings* LandRegistry::getPlayerSettings(mce::UUID const& uuid) {
     return &iter->second;
 }
 bool LandRegistry::setPlayerSettings(mce::UUID const& uuid, PlayerSettings settings) {
-    std::unique_lock<std::shared_mutex> lock(mMutex);
+    std::unique_lock<std::shared_mutex> lock(mSettingsMutex);
     mPlayerSettings[uuid] = std::move(settings);
     return true;
 }
 bool LandRegistry::hasPlayerSettings(mce::UUID const& uuid) const {
-    std::shared_lock<std::shared_mutex> lock(mMutex);
+    std::shared_lock<std::shared_mutex> lock(mSettingsMutex);
     return mPlayerSettings.find(uuid) != mPlayerSettings.end();
 }
 
@@ -373,13 +654,33 @@ ll::Expected<> LandRegistry::_addLand(SharedLand land) {
         return StorageError::make(StorageError::ErrorCode::CacheMapError, "Failed to insert land into cache map");
     }
 
-    mDimensionChunkMap.addLand(land);
+    _indexLand(land);
 
     return {};
 }
 void LandRegistry::refreshLandRange(SharedLand const& ptr) {
-    std::unique_lock<std::shared_mutex> lock(mMutex);
-    mDimensionChunkMap.refreshRange(ptr);
+    {
+        std::unique_lock<std::shared_mutex> lock(mMutex);
+        if (auto iter = mFamilyRoot.find(ptr->getId()); iter != mFamilyRoot.end()) {
+            mFamilyIndex[iter->second].insert(ptr->getId(), ptr->getAABB());
+        }
+
+        auto&                               shard = _shardOf(ptr->getDimensionId());
+        std::unique_lock<std::shared_mutex> shardLock(shard.mutex);
+        shard.chunkMap.refreshRange(ptr);
+        shard.spatialIndex[ptr->getDimensionId()].insert(ptr->getId(), ptr->getAABB());
+        _touchLayout();
+    }
+    if (auto manager = PLand::getInstance().getDrawHandleManager()) {
+        manager->invalidateLandGeometry(ptr); // 范围变更，共享绘制几何体失效
+    }
+}
+
+void LandRegistry::refreshLandName(Land const& land) {
+    std::unique_lock lock(mNameMutex);
+    if (mNameIndex.contains(land.getId())) { // 尚未加入注册表的领地在加入时建立索引
+        mNameIndex.insert(land.getId(), land.getName());
+    }
 }
 
 ll::Expected<> LandRegistry::addOrdinaryLand(SharedLand const& land) {
@@ -399,19 +700,22 @@ ll::Expected<> LandRegistry::addOrdinaryLand(SharedLand const& land) {
 
 ll::Expected<> LandRegistry::addSubLand(SharedLand const& parent, SharedLand const& sub) {
     if (!LandCreateValidator::isLandRangeLegal(sub->getAABB(), parent->getDimensionId(), true)
-        || !LandCreateValidator::isSubLandPositionLegal(parent, sub->getAABB())
+        || !LandCreateValidator::isSubLandPositionLegal(*this, parent, sub->getAABB())
         || parent->getDimensionId() != sub->getDimensionId()) {
         return StorageError::make(StorageError::ErrorCode::LandRangeIllegal, "The land range is illegal");
     }
+    // 加入注册表前设置父领地，子领地在分片中可见时父领地快照与家族索引即为正确值
+    auto originalParent         = sub->mContext.mParentLandID;
+    sub->mContext.mParentLandID = parent->getId();
+
     auto res = _addLand(sub);
     if (!res) {
+        sub->mContext.mParentLandID = originalParent;
         return res;
     }
     std::unique_lock<std::shared_mutex> lock(mMutex);
     parent->mContext.mSubLandIDs.push_back(sub->getId());
-    sub->mContext.mParentLandID = parent->getId();
     parent->mDirtyCounter.increment();
-    sub->mDirtyCounter.increment();
     return {};
 }
 
@@ -478,49 +782,49 @@ ll::Expected<> LandRegistry::removeLandAndSubLands(SharedLand const& ptr) {
         );
     }
 
-    auto currentId = ptr->getId();
-    auto parent    = ptr->getParentLand();
-    if (parent) {
-        std::erase_if(parent->mContext.mSubLandIDs, [&](LandID const& id) { return id == currentId; });
-        parent->mDirtyCounter.increment();
+    std::unique_lock<std::shared_mutex> lock(mMutex); // 整个过程持有写锁，缓存与层级的读者只能看到删除前或删除后的状态
+
+    // 1. 沿层级关系收集整棵子树
+    std::vector<SharedLand> subtree{ptr};
+    for (size_t i = 0; i < subtree.size(); ++i) {
+        for (auto const& id : subtree[i]->mContext.mSubLandIDs) {
+            auto iter = mLandCache.find(id);
+            if (iter == mLandCache.end()) {
+                return StorageError::make(
+                    StorageError::ErrorCode::DataConsistencyError,
+                    "The sub land is missing from cache"
+                );
+            }
+            subtree.push_back(iter->second);
+        }
     }
 
-    std::unique_lock<std::shared_mutex> lock(mMutex);
-    std::stack<SharedLand>              stack;        // 栈
-    std::vector<SharedLand>             removedLands; // 已移除的领地
-
-    stack.push(ptr);
-
-    while (!stack.empty()) {
-        auto current = stack.top();
-        stack.pop();
-
-        if (current->hasSubLand()) {
-            lock.unlock();
-            auto subLands = current->getSubLands();
-            lock.lock();
-            for (auto& subLand : subLands) {
-                stack.push(subLand);
+    // 2. 批量删除数据库记录，失败时恢复已删除的记录
+    std::vector<std::pair<std::string, std::string>> deleted; // key -> 原记录
+    deleted.reserve(subtree.size());
+    for (auto const& land : subtree) {
+        auto key  = std::to_string(land->getId());
+        auto data = land->dump().dump();
+        if (!mDB->del(key)) {
+            for (auto const& [k, v] : deleted) {
+                mDB->set(k, v);
             }
+            return StorageError::make(StorageError::ErrorCode::DatabaseError, "Failed to delete land from database");
         }
+        deleted.emplace_back(std::move(key), std::move(data));
+    }
 
-        auto result = _removeLand(current);
-        if (result.has_value()) {
-            removedLands.push_back(current);
-        } else {
-            // rollback
-            for (auto land : removedLands) {
-                mLandCache.emplace(land->getId(), land);
-                mDimensionChunkMap.addLand(land);
-            }
-            if (parent) {
-                parent->mContext.mSubLandIDs.push_back(currentId); // 恢复父领地的子领地列表
-                parent->mDirtyCounter.decrement();
-            }
-            // return std::unexpected("remove land or sub land failed!");
-            return result;
+    // 3. 数据库已提交，更新父领地记录、缓存与索引
+    if (ptr->hasParentLand()) {
+        if (auto parent = mLandCache.find(ptr->mContext.mParentLandID); parent != mLandCache.end()) {
+            std::erase(parent->second->mContext.mSubLandIDs, ptr->getId());
+            parent->second->mDirtyCounter.increment();
         }
     }
+    _unindexLands(subtree); // 整棵子树在同一次分片加锁内移除，点/范围查询不会看到删除一半的子树
+    for (auto const& land : subtree) {
+        mLandCache.erase(land->getId());
+    }
     return {};
 }
 ll::Expected<> LandRegistry::removeLandAndPromoteSubLands(SharedLand const& ptr) {
@@ -540,6 +844,7 @@ ll::Expected<> LandRegistry::removeLandAndPromoteSubLands(SharedLand const& ptr)
         subLand->mContext.mParentLandID = invalidID;
         subLand->mDirtyCounter.increment();
     }
+    _syncParents(subLands); // 所有子领地在同一次分片加锁内改挂
 
     auto result = _removeLand(ptr);
     if (!result.has_value()) {
@@ -549,7 +854,10 @@ ll::Expected<> LandRegistry::removeLandAndPromoteSubLands(SharedLand const& ptr)
             subLand->mContext.mParentLandID = currentId;
             subLand->mDirtyCounter.decrement();
         }
+        _syncParents(subLands);
+        return result;
     }
+    _reindexFamily(ptr->getId()); // 子领地提升为根领地，家族拆分
     return result;
 }
 ll::Expected<> LandRegistry::removeLandAndTransferSubLands(SharedLand const& ptr) {
@@ -575,6 +883,7 @@ ll::Expected<> LandRegistry::removeLandAndTransferSubLands(SharedLand const& ptr
         subLand->mDirtyCounter.increment();
         parent->mDirtyCounter.increment();
     }
+    _syncParents(subLands); // 所有子领地在同一次分片加锁内改挂
 
     // 父领地记录中擦粗当前领地
     std::erase_if(parent->mContext.mSubLandIDs, [&](LandID const& id) { return id == ptr->getId(); });
@@ -590,6 +899,7 @@ ll::Expected<> LandRegistry::removeLandAndTransferSubLands(SharedLand const& ptr
             subLand->mDirtyCounter.decrement();
             parent->mDirtyCounter.decrement();
         }
+        _syncParents(subLands);
         parent->mContext.mSubLandIDs.push_back(currentId); // 恢复父领地的子领地列表
         parent->mDirtyCounter.decrement();
     }
@@ -597,6 +907,118 @@ ll::Expected<> LandRegistry::removeLandAndTransferSubLands(SharedLand const& ptr
     return result;
 }
 
+ll::Expected<> LandRegistry::commit(LandBatch const& batch) {
+    using OpType = LandBatch::OpType;
+
+    if (batch.empty()) {
+        return {};
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mMutex);
+    if (auto res = _validateBatch(batch); !res) {
+        return res;
+    }
+
+    struct OwnerBackup {
+        SharedLand               land;
+        std::string              rawOwner;
+        std::optional<mce::UUID> cacheOwner;
+    };
+    std::vector<SharedLand>                      adds;
+    std::vector<SharedLand>                      removes;
+    std::vector<OwnerBackup>                     owners;
+    std::unordered_map<Land const*, std::string> originals; // 变更前的数据库记录
+    std::vector<SharedLand>                      writes;    // 需要写入数据库的领地(去重)
+    std::unordered_set<Land const*>              writeSet;
+
+    auto markWrite = [&](SharedLand const& land) {
+        if (writeSet.insert(land.get()).second) {
+            writes.push_back(land);
+        }
+    };
+
+    // 应用内存中的字段变更
+    for (auto const& op : batch.getOperations()) {
+        switch (op.type) {
+        case OpType::AddOrdinaryLand:
+            op.land->mContext.mLandID = getNextLandID();
+            adds.push_back(op.land);
+            markWrite(op.land);
+            break;
+        case OpType::RemoveOrdinaryLand:
+            originals.try_emplace(op.land.get(), op.land->dump().dump());
+            removes.push_back(op.land);
+            if (writeSet.erase(op.land.get())) {
+                std::erase(writes, op.land); // 先变更后移除，无需再写入
+            }
+            break;
+        case OpType::SetOwner:
+            if (!writeSet.contains(op.land.get())) {
+                originals.try_emplace(op.land.get(), op.land->dump().dump());
+            }
+            owners.push_back({op.land, op.land->mContext.mLandOwner, op.land->mCacheOwner});
+            op.land->setOwner(op.owner);
+            markWrite(op.land);
+            break;
+        }
+    }
+
+    auto rollbackFields = [&]() {
+        for (auto iter = owners.rbegin(); iter != owners.rend(); ++iter) {
+            iter->land->mContext.mLandOwner = iter->rawOwner;
+            iter->land->mCacheOwner         = iter->cacheOwner;
+        }
+        for (auto const& land : adds) {
+            land->mContext.mLandID = static_cast<LandID>(-1);
+        }
+    };
+
+    // 写入数据库，失败时按已写入的记录逆序恢复
+    std::vector<std::pair<std::string, std::optional<std::string>>> undo; // key -> 原记录(空表示原本不存在)
+    auto rollbackDatabase = [&]() {
+        for (auto iter = undo.rbegin(); iter != undo.rend(); ++iter) {
+            if (iter->second) {
+                mDB->set(iter->first, *iter->second);
+            } else {
+                mDB->del(iter->first);
+            }
+        }
+    };
+    for (auto const& land : removes) {
+        auto key = std::to_string(land->getId());
+        if (!mDB->del(key)) {
+            rollbackDatabase();
+            rollbackFields();
+            return StorageError::make(StorageError::ErrorCode::DatabaseError, "Failed to delete land from database");
+        }
+        undo.emplace_back(std::move(key), originals[land.get()]);
+    }
+    for (auto const& land : writes) {
+        auto key = std::to_string(land->getId());
+        if (!mDB->set(key, land->dump().dump())) {
+            rollbackDatabase();
+            rollbackFields();
+            return StorageError::make(StorageError::ErrorCode::DatabaseError, "Failed to write land to database");
+        }
+        auto original = originals.find(land.get());
+        undo.emplace_back(std::move(key), original != originals.end() ? std::optional{original->second} : std::nullopt);
+    }
+
+    // 数据库已提交，更新缓存与索引(空间索引在下次查询时统一重建)
+    _unindexLands(removes);
+    for (auto const& land : removes) {
+        mLandCache.erase(land->getId());
+    }
+    for (auto const& land : adds) {
+        mLandCache.emplace(land->getId(), land);
+    }
+    _indexLands(adds);
+    for (auto const& land : writes) {
+        land->mDirtyCounter.reset();
+    }
+    return {};
+}
+
 
 WeakLand LandRegistry::getLandWeakPtr(LandID id) const {
     std::shared_lock<std::shared_mutex> lock(mMutex);
@@ -696,8 +1118,6 @@ std::unordered_map<mce::UUID, std::unordered_set<SharedLand>> LandRegistry::getL
 
 
 LandPermType LandRegistry::getPermType(mce::UUID const& uuid, LandID id, bool includeOperator) const {
-    std::shared_lock<std::shared_mutex> lock(mMutex);
-
     if (includeOperator && isOperator(uuid)) return LandPermType::Operator;
 
     if (auto land = getLand(id); land) {
@@ -709,46 +1129,86 @@ LandPermType LandRegistry::getPermType(mce::UUID const& uuid, LandID id, bool in
 
 
 SharedLand LandRegistry::getLandAt(BlockPos const& pos, LandDimid dimid) const {
-    std::shared_lock<std::shared_mutex> lock(mMutex);
-    std::unordered_set<SharedLand>      result;
+    auto const key = LandSectionCache::makeKey(pos, dimid);
+    if (SharedLand cached; LandSectionCache::lookup(key, mLayoutEpoch.load(std::memory_order_acquire), cached)) {
+        return cached; // 区块段整体无领地或整体属于同一领地
+    }
+
+    auto const&                         shard = _shardOf(dimid);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return _getLandAt(shard, pos, dimid, key, mLayoutEpoch.load(std::memory_order_relaxed));
+}
 
-    auto landsIds = mDimensionChunkMap.queryLand(dimid, EncodeChunkID(pos.x >> 4, pos.z >> 4));
-    if (!landsIds) {
+SharedLand LandRegistry::_getLandAt(
+    DimensionShard const&        shard,
+    BlockPos const&              pos,
+    LandDimid                    dimid,
+    LandSectionCache::Key const& key,
+    uint64_t                     epoch
+) const {
+    auto landsIds = shard.chunkMap.queryLand(dimid, EncodeChunkID(pos.x >> 4, pos.z >> 4));
+    if (!landsIds || landsIds->empty()) {
+        LandSectionCache::store(key, epoch, nullptr);
         return nullptr;
     }
 
-    for (auto const& id : *landsIds) {
-        if (auto iter = mLandCache.find(id); iter != mLandCache.end()) {
-            if (auto const& land = iter->second; land->getAABB().hasPos(pos, land->is3D())) {
-                result.insert(land);
+    if (landsIds->size() == 1) {
+        if (auto iter = shard.lands.find(*landsIds->begin()); iter != shard.lands.end()) {
+            if (auto const& land = iter->second.land; LandSectionCache::covers(*land, key)) {
+                LandSectionCache::store(key, epoch, land);
+                return land;
             }
         }
     }
 
-    if (!result.empty()) {
-        if (result.size() == 1) {
-            return *result.begin(); // 只有一个领地，即普通领地
+    std::vector<ShardEntry const*> result;
+    for (auto const& id : *landsIds) {
+        if (auto iter = shard.lands.find(id); iter != shard.lands.end()) {
+            if (auto const& land = iter->second.land; land->getAABB().hasPos(pos, land->is3D())) {
+                result.push_back(&iter->second);
+            }
         }
+    }
 
-        // 子领地优先级最高
-        SharedLand deepestLand = nullptr;
-        int        maxLevel    = -1;
-        for (auto& land : result) {
-            int currentLevel = land->getNestedLevel();
-            if (currentLevel > maxLevel) {
-                maxLevel    = currentLevel;
-                deepestLand = land;
+    if (result.empty()) {
+        return nullptr;
+    }
+    if (result.size() == 1) {
+        return result.front()->land; // 只有一个领地，即普通领地
+    }
+
+    // 子领地优先级最高；子领地范围在父领地内，包含该位置的领地必然包含其全部祖先，
+    // 因此在候选集合内沿父领地快照计数即为嵌套层级，无需回到注册表查询
+    auto levelOf = [&](ShardEntry const* entry) {
+        int level = 0;
+        for (auto parent = entry->parent;;) {
+            auto iter = std::find_if(result.begin(), result.end(), [&](ShardEntry const* e) {
+                return e->land->getId() == parent;
+            });
+            if (iter == result.end()) {
+                return level;
             }
+            ++level;
+            parent = (*iter)->parent;
         }
-        return deepestLand;
-    }
+    };
 
-    return nullptr;
+    SharedLand deepestLand = nullptr;
+    int        maxLevel    = -1;
+    for (auto const* entry : result) {
+        int currentLevel = levelOf(entry);
+        if (currentLevel > maxLevel) {
+            maxLevel    = currentLevel;
+            deepestLand = entry->land;
+        }
+    }
+    return deepestLand;
 }
 std::unordered_set<SharedLand> LandRegistry::getLandAt(BlockPos const& center, int radius, LandDimid dimid) const {
-    std::shared_lock<std::shared_mutex> lock(mMutex);
+    auto const&                         shard = _shardOf(dimid);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
 
-    if (!mDimensionChunkMap.hasDimension(dimid)) {
+    if (!shard.chunkMap.hasDimension(dimid)) {
         return {};
     }
 
@@ -768,14 +1228,14 @@ std::unordered_set<SharedLand> LandRegistry::getLandAt(BlockPos const& center, i
             }
             visitedChunks.insert(chunkId);
 
-            auto landsIds = mDimensionChunkMap.queryLand(dimid, chunkId);
+            auto landsIds = shard.chunkMap.queryLand(dimid, chunkId);
             if (!landsIds) {
                 continue;
             }
 
             for (auto const& id : *landsIds) {
-                if (auto iter = mLandCache.find(id); iter != mLandCache.end()) {
-                    if (auto const& land = iter->second; land->isCollision(center, radius)) {
+                if (auto iter = shard.lands.find(id); iter != shard.lands.end()) {
+                    if (auto const& land = iter->second.land; land->isCollision(center, radius)) {
                         lands.insert(land);
                     }
                 }
@@ -786,9 +1246,10 @@ std::unordered_set<SharedLand> LandRegistry::getLandAt(BlockPos const& center, i
 }
 std::unordered_set<SharedLand>
 LandRegistry::getLandAt(BlockPos const& pos1, BlockPos const& pos2, LandDimid dimid) const {
-    std::shared_lock<std::shared_mutex> lock(mMutex);
+    auto const&                         shard = _shardOf(dimid);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
 
-    if (!mDimensionChunkMap.hasDimension(dimid)) {
+    if (!shard.chunkMap.hasDimension(dimid)) {
         return {};
     }
 
@@ -808,14 +1269,14 @@ LandRegistry::getLandAt(BlockPos const& pos1, BlockPos const& pos2, LandDimid di
             }
             visitedChunks.insert(chunkId);
 
-            auto landsIds = mDimensionChunkMap.queryLand(dimid, chunkId);
+            auto landsIds = shard.chunkMap.queryLand(dimid, chunkId);
             if (!landsIds) {
                 continue;
             }
 
             for (auto const& id : *landsIds) {
-                if (auto iter = mLandCache.find(id); iter != mLandCache.end()) {
-                    if (auto const& land = iter->second; land->isCollision(pos1, pos2)) {
+                if (auto iter = shard.lands.find(id); iter != shard.lands.end()) {
+                    if (auto const& land = iter->second.land; land->isCollision(pos1, pos2)) {
                         lands.insert(land);
                     }
                 }
@@ -825,6 +1286,70 @@ LandRegistry::getLandAt(BlockPos const& pos1, BlockPos const& pos2, LandDimid di
     return lands;
 }
 
+std::vector<SharedLand> LandRegistry::getLandsIntersecting(LandAABB const& range, LandDimid dimid) const {
+    return _queryLands(range, dimid);
+}
+
+std::vector<SharedLand> LandRegistry::_queryLands(LandAABB const& range, LandDimid dimid) const {
+    auto const&                         shard = _shardOf(dimid);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto index = shard.spatialIndex.find(dimid);
+    if (index == shard.spatialIndex.end()) {
+        return {};
+    }
+
+    std::vector<SharedLand> lands;
+    for (auto id : index->second.query(range)) {
+        if (auto iter = shard.lands.find(id); iter != shard.lands.end()) {
+            lands.push_back(iter->second.land);
+        }
+    }
+    return lands;
+}
+
+std::vector<SharedLand> LandRegistry::getFamilyLandsIntersecting(SharedLand const& land, LandAABB const& range) const {
+    std::shared_lock<std::shared_mutex> lock(mMutex);
+
+    auto rootId = land->getId();
+    if (auto iter = mFamilyRoot.find(rootId); iter != mFamilyRoot.end()) {
+        rootId = iter->second;
+    }
+    auto index = mFamilyIndex.find(rootId);
+    if (index == mFamilyIndex.end()) {
+        return {};
+    }
+
+    std::vector<SharedLand> lands;
+    for (auto id : index->second.query(range)) {
+        if (auto iter = mLandCache.find(id); iter != mLandCache.end()) {
+            lands.push_back(iter->second);
+        }
+    }
+    return lands;
+}
+
+std::vector<LandID> LandRegistry::searchLandsByName(std::string_view keyword) const {
+    std::shared_lock lock(mNameMutex);
+    return mNameIndex.search(keyword);
+}
+
+LandNameIndex::SearchResult
+LandRegistry::fuzzySearchLands(std::string_view keyword, size_t offset, size_t limit) const {
+    std::shared_lock lock(mNameMutex);
+    return mNameIndex.searchRanked(keyword, offset, limit);
+}
+
+std::vector<LandNameIndex::Match>
+LandRegistry::fuzzyRankLands(std::string_view keyword, std::span<LandID const> ids) const {
+    std::shared_lock lock(mNameMutex);
+    return mNameIndex.rank(keyword, ids);
+}
+
+uint64_t LandRegistry::getNameIndexVersion() const {
+    std::shared_lock lock(mNameMutex);
+    return mNameIndex.version();
+}
 
 std::vector<SharedLand> LandRegistry::getLandsWhere(FilterCallback const& callback) const {
     std::shared_lock<std::shared_mutex> lock(mMutex);
@@ -1,17 +1,25 @@
 #pragma once
+#include "LandBatch.h"
 #include "LandDimensionChunkMap.h"
 #include "LandIdAllocator.h"
+#include "LandNameIndex.h"
+#include "LandSectionCache.h"
+#include "LandSpatialIndex.h"
 #include "pland/Global.h"
+#include "pland/infra/JobScheduler.h"
 #include "pland/land/Land.h"
 
+#include "ll/api/coro/InterruptableSleep.h"
 #include "ll/api/data/KeyValueDB.h"
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <string_view>
-#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -33,19 +41,47 @@ struct PlayerSettings {
 
 class LandTemplatePermTable;
 
+/**
+ * @brief 领地注册表
+ *
+ * 锁划分:
+ * - mMutex: 领地缓存、家族索引、层级关系与数据库写入
+ * - DimensionShard::mutex: 按维度分片，保护该维度的区块映射、空间索引与父领地快照，点/范围查询只持有分片锁
+ * - mSettingsMutex: 操作员与玩家设置
+ * - mNameMutex: 领地名称索引
+ * 加锁顺序固定为 mMutex -> 分片(按下标升序) -> mSettingsMutex / mNameMutex，持有分片锁时不得再获取 mMutex
+ */
 class LandRegistry final {
-    std::unique_ptr<ll::data::KeyValueDB>         mDB;                             // 领地数据库
-    std::vector<mce::UUID>                        mLandOperators;                  // 领地操作员
-    std::unordered_map<mce::UUID, PlayerSettings> mPlayerSettings;                 // 玩家设置
-    std::unordered_map<LandID, SharedLand>        mLandCache;                      // 领地缓存
-    mutable std::shared_mutex                     mMutex;                          // 读写锁
-    std::unique_ptr<LandIdAllocator>              mLandIdAllocator{nullptr};       // 领地ID分配器
-    LandDimensionChunkMap                         mDimensionChunkMap;              // 维度区块映射
-    std::unique_ptr<LandTemplatePermTable>        mLandTemplatePermTable{nullptr}; // 领地模板权限表
-    std::thread                                   mThread;                         // 线程
-    std::atomic<bool>                             mThreadQuit{false};              // 线程退出标志
-    mutable std::mutex                            mThreadMutex;                    // 线程互斥锁(仅 mThreadCV 使用)
-    std::condition_variable                       mThreadCV;                       // 线程条件变量
+    static constexpr size_t DimensionShardCount = 4; // 维度分片数(维度ID取模)
+
+    struct ShardEntry {
+        SharedLand land;
+        LandID     parent; // 父领地ID快照，查询时无需回到注册表
+    };
+    struct DimensionShard {
+        mutable std::shared_mutex                       mutex;
+        LandDimensionChunkMap                           chunkMap;     // 维度区块映射
+        std::unordered_map<LandDimid, LandSpatialIndex> spatialIndex; // 维度空间索引
+        std::unordered_map<LandID, ShardEntry>          lands;        // 该分片内的领地
+    };
+
+    std::unique_ptr<ll::data::KeyValueDB>           mDB;                             // 领地数据库
+    std::vector<mce::UUID>                          mLandOperators;                  // 领地操作员
+    std::unordered_map<mce::UUID, PlayerSettings>   mPlayerSettings;                 // 玩家设置
+    mutable std::shared_mutex                       mSettingsMutex;                  // 操作员/玩家设置读写锁
+    std::unordered_map<LandID, SharedLand>          mLandCache;                      // 领地缓存
+    mutable std::shared_mutex                       mMutex;                          // 读写锁
+    std::unique_ptr<LandIdAllocator>                mLandIdAllocator{nullptr};       // 领地ID分配器
+    std::array<DimensionShard, DimensionShardCount> mShards;                         // 维度分片
+    std::unordered_map<LandID, LandSpatialIndex>    mFamilyIndex;                    // 根领地 -> 子孙领地空间索引
+    std::unordered_map<LandID, LandID>              mFamilyRoot;                     // 子孙领地 -> 根领地
+    LandNameIndex                                   mNameIndex;                      // 领地名称索引
+    mutable std::shared_mutex                       mNameMutex;                      // 名称索引读写锁
+    std::atomic<uint64_t>                           mLayoutEpoch{0};                 // 布局版本(范围/层级变更时更新)
+    std::unique_ptr<LandTemplatePermTable>          mLandTemplatePermTable{nullptr}; // 领地模板权限表
+    std::shared_ptr<std::atomic<bool>>              mSaveQuit{nullptr};              // 定时保存退出标志
+    std::shared_ptr<ll::coro::InterruptableSleep>   mSaveSleep{nullptr};             // 定时保存等待
+    JobScheduler::Handle                            mSaveJob;                        // 最近一次提交的保存任务
 
     friend class DataConverter;
 
@@ -60,6 +96,39 @@ class LandRegistry final {
 
     void _buildDimensionChunkMap();
 
+    DimensionShard&                     _shardOf(LandDimid dimid);
+    [[nodiscard]] DimensionShard const& _shardOf(LandDimid dimid) const;
+
+    // 按下标升序获取 lands 涉及的分片写锁
+    std::vector<std::unique_lock<std::shared_mutex>> _lockShards(std::span<SharedLand const> lands);
+
+    void _indexLand(SharedLand const& land);   // 同步维度区块映射、空间索引与名称索引(获取分片写锁)
+    void _unindexLand(SharedLand const& land); // 从维度区块映射、空间索引与名称索引中移除(获取分片写锁)
+
+    // 批量版本，所有领地在同一次分片加锁内完成，读者只能看到全部变更前或全部变更后的状态
+    void _indexLands(std::span<SharedLand const> lands);
+    void _unindexLands(std::span<SharedLand const> lands);
+    void _syncParents(std::span<SharedLand const> lands); // 层级变更后同步分片中的父领地快照
+
+    void _indexFamilyMember(SharedLand const& land); // 加入根领地的家族索引(需已设置父领地)
+    void _unindexFamilyMember(LandID id);
+    void _reindexFamily(LandID rootId);              // 根领地变更后重建家族索引
+
+    void _touchLayout(); // 更新布局版本，使区块段缓存失效
+
+    std::vector<SharedLand> _queryLands(LandAABB const& range, LandDimid dimid) const; // 获取分片读锁
+
+    // 需持有 shard 的读锁
+    SharedLand _getLandAt(
+        DimensionShard const&        shard,
+        BlockPos const&              pos,
+        LandDimid                    dimid,
+        LandSectionCache::Key const& key,
+        uint64_t                     epoch
+    ) const;
+
+    ll::Expected<> _validateBatch(LandBatch const& batch) const;
+
     LandID getNextLandID() const;
 
     ll::Expected<> _removeLand(SharedLand const& ptr);
@@ -95,6 +164,8 @@ class LandRegistry final {
 
     LDAPI void refreshLandRange(SharedLand const& ptr); // 刷新领地范围
 
+    LDAPI void refreshLandName(Land const& land); // 刷新名称索引(Land::setName 自动调用)
+
     LDNDAPI ll::Expected<> addOrdinaryLand(SharedLand const& land);
 
     LDNDAPI ll::Expected<> addSubLand(SharedLand const& parent, SharedLand const& sub);
@@ -130,6 +201,12 @@ class LandRegistry final {
      */
     LDNDAPI ll::Expected<> removeLandAndTransferSubLands(SharedLand const& ptr);
 
+    /**
+     * @brief 提交批量操作
+     * @note 整批校验后在同一写锁内应用，并立即写入数据库；任一步骤失败则整批回滚
+     */
+    LDNDAPI ll::Expected<> commit(LandBatch const& batch);
+
 
 public: // 领地查询API
     LDNDAPI WeakLand   getLandWeakPtr(LandID id) const;
@@ -150,6 +227,42 @@ class LandRegistry final {
 
     LDNDAPI std::unordered_set<SharedLand> getLandAt(BlockPos const& pos1, BlockPos const& pos2, LandDimid dimid) const;
 
+    /**
+     * @brief 查询与范围相交的领地(空间索引，耗时与范围大小无关)
+     */
+    LDNDAPI std::vector<SharedLand> getLandsIntersecting(LandAABB const& range, LandDimid dimid) const;
+
+    /**
+     * @brief 查询 land 所在家族中(不含根领地)与范围相交的子孙领地
+     */
+    LDNDAPI std::vector<SharedLand> getFamilyLandsIntersecting(SharedLand const& land, LandAABB const& range) const;
+
+    /**
+     * @brief 查找名称包含关键字的领地(忽略 ASCII 大小写)
+     * @return 领地ID(升序)
+     * @note 使用名称三元组索引，不遍历全部领地
+     */
+    LDNDAPI std::vector<LandID> searchLandsByName(std::string_view keyword) const;
+
+    /**
+     * @brief 按名称模糊搜索领地，结果按相关度降序分页
+     * @param offset 跳过的结果数
+     * @param limit  最多返回的结果数
+     */
+    LDNDAPI LandNameIndex::SearchResult
+    fuzzySearchLands(std::string_view keyword, size_t offset = 0, size_t limit = 50) const;
+
+    /**
+     * @brief 名称索引的变更计数，用于判断缓存的搜索结果是否过期
+     */
+    LDNDAPI uint64_t getNameIndexVersion() const;
+
+    /**
+     * @brief 只在给定领地中模糊搜索，结果按相关度降序
+     */
+    LDNDAPI std::vector<LandNameIndex::Match>
+    fuzzyRankLands(std::string_view keyword, std::span<LandID const> ids) const;
+
     using FilterCallback = std::function<bool(SharedLand const&)>;
     LDNDAPI std::vector<SharedLand> getLandsWhere(FilterCallback const& callback) const;
 
@@ -6,7 +6,6 @@
 #include "ll/api/event/player/PlayerDisconnectEvent.h"
 #include "ll/api/event/player/PlayerJoinEvent.h"
 #include "ll/api/service/Bedrock.h"
-#include "ll/api/service/PlayerInfo.h"
 #include "ll/api/thread/ServerThreadExecutor.h"
 #include "mc/network/packet/SetTitlePacket.h"
 #include "mc/server/ServerPlayer.h"
@@ -16,6 +15,7 @@
 #include "pland/Global.h"
 #include "pland/PLand.h"
 #include "pland/infra/Config.h"
+#include "pland/infra/PlayerNameCache.h"
 #include "pland/land/LandEvent.h"
 #include "pland/land/LandRegistry.h"
 #include <cstdio>
@@ -199,8 +199,8 @@ void LandScheduler::tickEvent() {
 }
 
 void LandScheduler::tickLandTip() {
-    auto& playerInfo = ll::service::PlayerInfo::getInstance();
-    auto& registry   = PLand::getInstance().getLandRegistry();
+    auto& names    = *PLand::getInstance().getPlayerNameCache();
+    auto& registry = PLand::getInstance().getLandRegistry();
 
     SetTitlePacket pkt(SetTitlePacket::TitleType::Actionbar);
     for (auto& [player, landId] : mLandIdMap) {
@@ -218,12 +218,10 @@ void LandScheduler::tickLandTip() {
             continue;
         }
 
-        auto& owner = land->getOwner();
-        auto  info  = playerInfo.fromUuid(owner);
         if (land->isOwner(player->getUuid())) {
             pkt.mTitleText = "[Land] 当前正在领地 {}"_trf(*player, land->getName());
         } else {
-            pkt.mTitleText = "[Land] 这里是 {} 的领地"_trf(*player, info.has_value() ? info->name : owner.asString());
+            pkt.mTitleText = "[Land] 这里是 {} 的领地"_trf(*player, names.resolve(land->getOwner()));
         }
 
         pkt.sendTo(*player);
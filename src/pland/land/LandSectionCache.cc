@@ -0,0 +1,76 @@
+#include "pland/land/LandSectionCache.h"
+
+#include "mc/world/level/BlockPos.h"
+
+#include <array>
+#include <atomic>
+
+
+namespace land {
+
+namespace {
+
+struct Slot {
+    uint64_t              epoch{0}; // 0 为空槽
+    LandSectionCache::Key key{};
+    bool                  hasLand{false};
+    WeakLand              land;
+};
+
+std::atomic<uint64_t> NextEpoch{0};
+
+Slot& slotOf(LandSectionCache::Key const& key) {
+    thread_local std::array<Slot, LandSectionCache::Capacity> slots;
+
+    auto hash = static_cast<uint32_t>(key.x) * 0x9E3779B1u ^ static_cast<uint32_t>(key.z) * 0x85EBCA77u
+              ^ static_cast<uint32_t>(key.y) * 0xC2B2AE3Du ^ static_cast<uint32_t>(key.dimid);
+    return slots[(hash ^ hash >> 16) & (LandSectionCache::Capacity - 1)];
+}
+
+} // namespace
+
+
+LandSectionCache::Key LandSectionCache::makeKey(BlockPos const& pos, LandDimid dimid) {
+    return Key{dimid, pos.x >> 4, pos.y >> 4, pos.z >> 4};
+}
+
+uint64_t LandSectionCache::nextEpoch() { return NextEpoch.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+bool LandSectionCache::covers(Land const& land, Key const& key) {
+    auto const& aabb = land.getAABB();
+
+    int minX = key.x << 4, maxX = minX + 15;
+    int minZ = key.z << 4, maxZ = minZ + 15;
+    if (aabb.min.x > minX || aabb.max.x < maxX || aabb.min.z > minZ || aabb.max.z < maxZ) {
+        return false;
+    }
+    if (!land.is3D()) {
+        return true;
+    }
+    int minY = key.y << 4, maxY = minY + 15;
+    return aabb.min.y <= minY && aabb.max.y >= maxY;
+}
+
+bool LandSectionCache::lookup(Key const& key, uint64_t epoch, SharedLand& land) {
+    auto& slot = slotOf(key);
+    if (slot.epoch == 0 || slot.epoch != epoch || slot.key != key) {
+        return false;
+    }
+    if (!slot.hasLand) {
+        land = nullptr;
+        return true;
+    }
+    land = slot.land.lock();
+    return land != nullptr;
+}
+
+void LandSectionCache::store(Key const& key, uint64_t epoch, SharedLand const& land) {
+    auto& slot   = slotOf(key);
+    slot.epoch   = epoch;
+    slot.key     = key;
+    slot.hasLand = land != nullptr;
+    slot.land    = land;
+}
+
+
+} // namespace land
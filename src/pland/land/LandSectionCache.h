@@ -0,0 +1,59 @@
+#pragma once
+#include "pland/Global.h"
+#include "pland/land/Land.h"
+
+#include <cstdint>
+
+class BlockPos;
+
+namespace land {
+
+
+/**
+ * @brief 区块段(16x16x16)领地摘要缓存
+ *
+ * 记录某个区块段"整体不在任何领地内"或"整体属于同一个领地"，命中时 getLandAt 无需加锁、无需 AABB 判断。
+ * 区块段内存在多个领地或领地只覆盖一部分时不缓存，回退到精确查询。
+ * 缓存只保存领地本身，权限在使用时读取，权限变更无需失效；范围/层级变更时由 LandRegistry 更新布局版本号使其失效。
+ *
+ * @note 每个线程独立的直接映射缓存(固定容量，冲突时覆盖)，读写均无锁
+ */
+class LandSectionCache final {
+public:
+    static constexpr size_t Capacity = 1024; // 每线程槽位数(2 的幂)
+
+    struct Key {
+        LandDimid dimid;
+        int       x, y, z; // 区块段坐标
+
+        bool operator==(Key const&) const = default;
+    };
+
+    LDNDAPI static Key makeKey(BlockPos const& pos, LandDimid dimid);
+
+    /**
+     * @brief 生成新的布局版本号(全局递增，不同 LandRegistry 实例之间也不重复，0 保留为无效)
+     */
+    LDNDAPI static uint64_t nextEpoch();
+
+    /**
+     * @brief 领地是否完整覆盖该区块段(2D 领地不考虑 Y 轴)
+     */
+    LDNDAPI static bool covers(Land const& land, Key const& key);
+
+    /**
+     * @brief 查询缓存
+     * @param land 命中时写入，nullptr 表示区块段内没有领地
+     * @return 是否命中(版本号一致且领地仍然存在)
+     */
+    LDNDAPI static bool lookup(Key const& key, uint64_t epoch, SharedLand& land);
+
+    /**
+     * @brief 写入缓存，land 为 nullptr 表示区块段内没有领地
+     * @note 调用方需保证 land 在 epoch 版本下完整覆盖该区块段
+     */
+    LDAPI static void store(Key const& key, uint64_t epoch, SharedLand const& land);
+};
+
+
+} // namespace land
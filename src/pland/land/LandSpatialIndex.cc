@@ -0,0 +1,201 @@
+#include "LandSpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace land {
+
+namespace {
+
+LandAABB mergeBounds(LandAABB const& a, LandAABB const& b) {
+    return LandAABB{
+        LandPos{std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)},
+        LandPos{std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)}
+    };
+}
+
+// 中心坐标的两倍，避免除法
+inline int64_t centerX(LandAABB const& aabb) { return static_cast<int64_t>(aabb.min.x) + aabb.max.x; }
+inline int64_t centerZ(LandAABB const& aabb) { return static_cast<int64_t>(aabb.min.z) + aabb.max.z; }
+
+/**
+ * @brief STR(Sort-Tile-Recursive) 排序：先按 X 切分为若干竖条，每个竖条内再按 Z 排序
+ */
+template <typename T, typename GetBounds>
+void strSort(std::vector<T>& values, GetBounds getBounds) {
+    auto const count      = values.size();
+    auto const leafCount  = (count + LandSpatialIndex::NodeCapacity - 1) / LandSpatialIndex::NodeCapacity;
+    auto const sliceCount = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(leafCount))));
+    auto const sliceSize  = std::max<size_t>(sliceCount * LandSpatialIndex::NodeCapacity, 1);
+
+    std::sort(values.begin(), values.end(), [&](T const& a, T const& b) {
+        return centerX(getBounds(a)) < centerX(getBounds(b));
+    });
+    for (size_t begin = 0; begin < count; begin += sliceSize) {
+        auto end = std::min(begin + sliceSize, count);
+        std::sort(values.begin() + begin, values.begin() + end, [&](T const& a, T const& b) {
+            return centerZ(getBounds(a)) < centerZ(getBounds(b));
+        });
+    }
+}
+
+/**
+ * @brief 将连续的 NodeCapacity 个元素打包为一个节点
+ */
+template <typename Node, typename T, typename GetBounds>
+std::vector<Node> packLevel(std::vector<T> const& values, GetBounds getBounds) {
+    std::vector<Node> nodes;
+    nodes.reserve((values.size() + LandSpatialIndex::NodeCapacity - 1) / LandSpatialIndex::NodeCapacity);
+    for (size_t begin = 0; begin < values.size(); begin += LandSpatialIndex::NodeCapacity) {
+        auto     end    = std::min(begin + LandSpatialIndex::NodeCapacity, values.size());
+        LandAABB bounds = getBounds(values[begin]);
+        for (size_t i = begin + 1; i < end; ++i) {
+            bounds = mergeBounds(bounds, getBounds(values[i]));
+        }
+        nodes.push_back({bounds, static_cast<uint32_t>(begin), static_cast<uint32_t>(end - begin)});
+    }
+    return nodes;
+}
+
+} // namespace
+
+
+void LandSpatialIndex::_markPending() {
+    auto threshold = std::clamp(mItems.size() / 8, MinDeltaSize, MaxDeltaSize);
+    if (mDelta.size() + mTombstones.size() > threshold) {
+        mNeedsRepack.store(true, std::memory_order_release);
+    }
+}
+
+void LandSpatialIndex::_ensurePacked() const {
+    if (!mNeedsRepack.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard lock(mBuildMutex);
+    if (!mNeedsRepack.load(std::memory_order_relaxed)) {
+        return; // 其他读者已完成合并
+    }
+    _repack();
+    mNeedsRepack.store(false, std::memory_order_release);
+}
+
+void LandSpatialIndex::_repack() const {
+    mItems.clear();
+    mLevels.clear();
+    mDelta.clear();
+    mDeltaIndex.clear();
+    mTombstones.clear();
+    mItems.reserve(mEntries.size());
+    for (auto const& [id, aabb] : mEntries) {
+        mItems.push_back({id, aabb});
+    }
+    if (mItems.empty()) {
+        return;
+    }
+
+    auto itemBounds = [](Item const& item) -> LandAABB const& { return item.aabb; };
+    auto nodeBounds = [](Node const& node) -> LandAABB const& { return node.bounds; };
+
+    strSort(mItems, itemBounds);
+    auto level = packLevel<Node>(mItems, itemBounds);
+    while (level.size() > 1) {
+        strSort(level, nodeBounds); // 仅重排本层，子节点下标仍指向下一层
+        auto parent = packLevel<Node>(level, nodeBounds);
+        mLevels.push_back(std::move(level));
+        level = std::move(parent);
+    }
+    mLevels.push_back(std::move(level)); // 根层
+}
+
+void LandSpatialIndex::insert(LandID id, LandAABB const& aabb) {
+    auto [iter, inserted] = mEntries.insert_or_assign(id, aabb);
+    if (auto delta = mDeltaIndex.find(id); delta != mDeltaIndex.end()) {
+        mDelta[delta->second].aabb = aabb; // 已在增量表中，原地更新
+        return;
+    }
+    if (!inserted) {
+        mTombstones.insert(id); // 打包树中的旧范围失效
+    }
+    mDeltaIndex.emplace(id, mDelta.size());
+    mDelta.push_back({id, aabb});
+    _markPending();
+}
+
+void LandSpatialIndex::erase(LandID id) {
+    if (!mEntries.erase(id)) {
+        return;
+    }
+    if (auto delta = mDeltaIndex.find(id); delta != mDeltaIndex.end()) {
+        // 与末尾交换后弹出，保持增量表紧凑
+        auto index = delta->second;
+        mDeltaIndex.erase(delta);
+        if (index + 1 != mDelta.size()) {
+            mDelta[index]                 = mDelta.back();
+            mDeltaIndex[mDelta[index].id] = index;
+        }
+        mDelta.pop_back();
+        return; // 若曾在打包树中，更新时已记入墓碑
+    }
+    mTombstones.insert(id);
+    _markPending();
+}
+
+void LandSpatialIndex::clear() {
+    mEntries.clear();
+    mItems.clear();
+    mLevels.clear();
+    mDelta.clear();
+    mDeltaIndex.clear();
+    mTombstones.clear();
+    mNeedsRepack.store(false, std::memory_order_release);
+}
+
+bool LandSpatialIndex::contains(LandID id) const { return mEntries.contains(id); }
+
+size_t LandSpatialIndex::size() const { return mEntries.size(); }
+
+std::vector<LandID> LandSpatialIndex::query(LandAABB const& range) const {
+    _ensurePacked();
+
+    std::vector<LandID> result;
+    for (auto const& item : mDelta) {
+        if (LandAABB::isCollision(item.aabb, range)) {
+            result.push_back(item.id);
+        }
+    }
+    if (mLevels.empty()) {
+        return result;
+    }
+
+    std::vector<std::pair<size_t, uint32_t>> stack; // (层, 节点下标)
+    for (uint32_t i = 0; i < mLevels.back().size(); ++i) {
+        stack.emplace_back(mLevels.size() - 1, i);
+    }
+    while (!stack.empty()) {
+        auto [depth, index] = stack.back();
+        stack.pop_back();
+
+        auto const& node = mLevels[depth][index];
+        if (!LandAABB::isCollision(node.bounds, range)) {
+            continue;
+        }
+        if (depth == 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                auto const& item = mItems[i];
+                if (LandAABB::isCollision(item.aabb, range)
+                    && (mTombstones.empty() || !mTombstones.contains(item.id))) {
+                    result.push_back(item.id);
+                }
+            }
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            stack.emplace_back(depth - 1, i);
+        }
+    }
+    return result;
+}
+
+
+} // namespace land
@@ -0,0 +1,77 @@
+#pragma once
+#include "pland/Global.h"
+#include "pland/aabb/LandAABB.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace land {
+
+
+/**
+ * @brief 领地空间索引(STR 打包 R 树)
+ *
+ * 维护一组领地的 AABB，支持按范围查询相交的领地，查询代价为 O(log n + k)，与查询范围大小无关。
+ * 增删改为 O(1)：新增/更新的条目进入无序增量表，打包树中失效的条目记入墓碑集合，查询时一并扫描；
+ * 增量与墓碑累计超过阈值后，由下一次查询将其合并进打包树。
+ *
+ * @note 增删改非线程安全，需由调用方持有写锁；查询可在多个读者间并发
+ */
+class LandSpatialIndex final {
+    struct Item {
+        LandID   id;
+        LandAABB aabb;
+    };
+    struct Node {
+        LandAABB bounds;
+        uint32_t first; // 子节点(或叶子的条目)起始下标
+        uint32_t count; // 子节点(或叶子的条目)数量
+    };
+
+    std::unordered_map<LandID, LandAABB>       mEntries;            // 原始数据
+    mutable std::vector<Item>                  mItems;              // 叶子条目(按 STR 顺序排列)
+    mutable std::vector<std::vector<Node>>     mLevels;             // 各层节点，mLevels[0] 为叶子层
+    mutable std::vector<Item>                  mDelta;              // 未打包的新增/更新条目(无序)
+    mutable std::unordered_map<LandID, size_t> mDeltaIndex;         // 增量条目下标
+    mutable std::unordered_set<LandID>         mTombstones;         // 打包树中已失效的条目
+    mutable std::atomic<bool>                  mNeedsRepack{false}; // 增量超过阈值，待合并
+    mutable std::mutex                         mBuildMutex;         // 重建互斥锁
+
+    void _markPending();
+    void _ensurePacked() const;
+    void _repack() const;
+
+public:
+    static constexpr uint32_t NodeCapacity = 16;   // 节点容量
+    static constexpr size_t   MinDeltaSize = 64;   // 增量阈值下限
+    static constexpr size_t   MaxDeltaSize = 1024; // 增量阈值上限(限制查询时的线性扫描)
+
+    LD_DISABLE_COPY_AND_MOVE(LandSpatialIndex);
+    explicit LandSpatialIndex() = default;
+
+    /**
+     * @brief 插入或更新领地范围
+     */
+    LDAPI void insert(LandID id, LandAABB const& aabb);
+
+    LDAPI void erase(LandID id);
+
+    LDAPI void clear();
+
+    LDNDAPI bool contains(LandID id) const;
+
+    LDNDAPI size_t size() const;
+
+    /**
+     * @brief 查询与范围相交(含边界接触)的所有领地
+     */
+    LDNDAPI std::vector<LandID> query(LandAABB const& range) const;
+};
+
+
+} // namespace land